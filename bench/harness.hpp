@@ -0,0 +1,205 @@
+#ifndef RABBITXX_BENCH_HARNESS_HPP
+#define RABBITXX_BENCH_HARNESS_HPP
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace bench {
+
+/**
+ * @brief Prevent the compiler from optimizing away a computed value.
+ */
+template<typename T>
+inline void do_not_optimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct result
+{
+    std::string name;
+    // wall clock time of each iteration in nanoseconds
+    std::vector<double> samples;
+    // user defined counters, e.g. number of vertices or sets
+    std::map<std::string, double> counters;
+
+    double min() const
+    {
+        return *std::min_element(samples.begin(), samples.end());
+    }
+
+    double max() const
+    {
+        return *std::max_element(samples.begin(), samples.end());
+    }
+
+    double mean() const
+    {
+        return std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    }
+
+    double median() const
+    {
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        const auto mid = sorted.size() / 2;
+        return sorted.size() % 2 == 0 ? (sorted[mid - 1] + sorted[mid]) / 2.0 : sorted[mid];
+    }
+
+    double stddev() const
+    {
+        const auto m = mean();
+        double sq_sum = 0.0;
+        for (const auto s : samples)
+        {
+            sq_sum += (s - m) * (s - m);
+        }
+        return std::sqrt(sq_sum / samples.size());
+    }
+};
+
+/**
+ * @brief Minimal benchmark harness.
+ *
+ * Every benchmark runs at least `min_iterations` times and until
+ * `min_time` has been spent in the measured body. Setup work, which is
+ * necessary to run a body repeatedly, e.g. copying its input, is not
+ * measured.
+ */
+class harness
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    harness(std::size_t min_iterations, std::chrono::duration<double> min_time)
+        : min_iterations_(min_iterations), min_time_(min_time)
+    {
+    }
+
+    /**
+     * @brief Run `body(setup())` repeatedly and record the time of each body.
+     *
+     * @return The result, counters may be added to it afterwards.
+     */
+    template<typename Setup, typename Body>
+    result& run(const std::string& name, Setup&& setup, Body&& body)
+    {
+        result res;
+        res.name = name;
+        std::chrono::duration<double> spent(0);
+        while (res.samples.size() < min_iterations_ || spent < min_time_)
+        {
+            auto input = setup();
+            const auto start = clock::now();
+            body(input);
+            const auto end = clock::now();
+            spent += end - start;
+            res.samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        results_.push_back(std::move(res));
+        return results_.back();
+    }
+
+    template<typename Body>
+    result& run(const std::string& name, Body&& body)
+    {
+        return run(name, [] { return 0; }, [&body](int) { body(); });
+    }
+
+    const std::deque<result>& results() const noexcept
+    {
+        return results_;
+    }
+
+    void print(std::ostream& os) const
+    {
+        os << std::left << std::setw(40) << "benchmark" << std::right
+           << std::setw(8) << "iter"
+           << std::setw(16) << "median [ms]"
+           << std::setw(16) << "mean [ms]"
+           << std::setw(16) << "stddev [ms]" << "\n";
+        for (const auto& res : results_)
+        {
+            os << std::left << std::setw(40) << res.name << std::right
+               << std::setw(8) << res.samples.size() << std::fixed << std::setprecision(3)
+               << std::setw(16) << res.median() / 1e6
+               << std::setw(16) << res.mean() / 1e6
+               << std::setw(16) << res.stddev() / 1e6 << "\n";
+        }
+    }
+
+    /**
+     * @brief Write all results as json, so runs of different commits can be
+     * compared.
+     */
+    void write_json(std::ostream& os, const std::map<std::string, std::string>& context) const
+    {
+        rapidjson::OStreamWrapper osw(os);
+        rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer(osw);
+        writer.StartObject();
+        writer.Key("context");
+        writer.StartObject();
+        for (const auto& kvp : context)
+        {
+            writer.Key(kvp.first.c_str());
+            writer.String(kvp.second.c_str());
+        }
+        writer.EndObject();
+        writer.Key("benchmarks");
+        writer.StartArray();
+        for (const auto& res : results_)
+        {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(res.name.c_str());
+            writer.Key("iterations");
+            writer.Uint64(res.samples.size());
+            writer.Key("time_unit");
+            writer.String("ns");
+            writer.Key("min");
+            writer.Double(res.min());
+            writer.Key("median");
+            writer.Double(res.median());
+            writer.Key("mean");
+            writer.Double(res.mean());
+            writer.Key("max");
+            writer.Double(res.max());
+            writer.Key("stddev");
+            writer.Double(res.stddev());
+            writer.Key("counters");
+            writer.StartObject();
+            for (const auto& counter : res.counters)
+            {
+                writer.Key(counter.first.c_str());
+                writer.Double(counter.second);
+            }
+            writer.EndObject();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+        os << "\n";
+    }
+
+private:
+    std::size_t min_iterations_;
+    std::chrono::duration<double> min_time_;
+    // deque keeps references to earlier results valid
+    std::deque<result> results_;
+};
+
+}} // namespace rabbitxx::bench
+
+#endif // RABBITXX_BENCH_HARNESS_HPP
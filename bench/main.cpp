@@ -0,0 +1,330 @@
+#include "harness.hpp"
+#include "bench_revision.hpp"
+
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/csv.hpp>
+#include <rabbitxx/graph.hpp>
+#include <rabbitxx/log.hpp>
+#include <rabbitxx/synthetic_graph.hpp>
+#include <rabbitxx/utils.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+/**
+ * Stage-level benchmarks of the rabbitxx pipeline.
+ *
+ * stages:
+ *  ingestion/<trace>:      otf2 trace to `IoGraph`
+ *  pio_sets/<trace>:       `cio_sets_per_process`
+ *  cio_merge/<trace>:      `find_cio_sets` with given per-process sets
+ *  csv_output/<trace>:     all CIO-Sets as csv into memory
+ *  module/<name>:          complete run of a module executable on the trace
+ *  logging/...:           trace statement of a callback, compiled out vs.
+ *                          filtered at runtime
+ *  synthetic/<model>/...:  `make_synthetic_graph` followed by the set stages,
+ *                          without any trace file
+ */
+
+using namespace rabbitxx;
+namespace po = boost::program_options;
+
+namespace
+{
+
+std::string trace_label(const std::string& trace)
+{
+    // use the archive directory, the anchor file is usually called traces.otf2
+    const auto dir = fs::path(trace).parent_path().filename();
+    return dir.empty() ? fs::path(trace).filename().string() : dir.string();
+}
+
+void bench_trace(bench::harness& h, const std::string& trace, const graph::builder_config& config)
+{
+    const auto label = trace_label(trace);
+
+    auto& ingestion = h.run("ingestion/" + label, [&trace, &config] {
+        auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(trace, config);
+        bench::do_not_optimize(graph.num_vertices());
+    });
+
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(trace, config);
+    ingestion.counters["vertices"] = graph.num_vertices();
+    ingestion.counters["edges"] = graph.num_edges();
+
+    auto& pio = h.run("pio_sets/" + label, [&graph] {
+        auto sets_pp = cio_sets_per_process(graph);
+        bench::do_not_optimize(sets_pp.size());
+    });
+
+    const auto sets_pp = cio_sets_per_process(graph);
+    std::uint64_t num_pio_sets = 0;
+    for (const auto& kvp : sets_pp)
+    {
+        num_pio_sets += kvp.second.size();
+    }
+    pio.counters["pio_sets"] = num_pio_sets;
+
+    // merging modifies the per-process sets, so every iteration gets a copy
+    auto& merge = h.run("cio_merge/" + label,
+        [&sets_pp] { return sets_pp; },
+        [&graph](set_map_t<VertexDescriptor>& sets) {
+            auto cio_sets = find_cio_sets(graph, sets);
+            bench::do_not_optimize(cio_sets.size());
+        });
+
+    auto sets_copy = sets_pp;
+    const auto cio_sets = find_cio_sets(graph, sets_copy);
+    merge.counters["cio_sets"] = cio_sets.size();
+
+    auto& csv = h.run("csv_output/" + label, [&graph, &cio_sets] {
+        std::ostringstream out;
+        for (const auto& set : cio_sets)
+        {
+            set2csv(graph, set, out);
+        }
+        bench::do_not_optimize(out.tellp());
+    });
+    std::ostringstream out;
+    for (const auto& set : cio_sets)
+    {
+        set2csv(graph, set, out);
+    }
+    csv.counters["bytes"] = out.str().size();
+}
+
+/**
+ * @brief Parse a synthetic graph model given as
+ * procs:phases:io_per_phase[:comm_size[:p2p_density]].
+ */
+synthetic_graph_config parse_model(const std::string& model)
+{
+    std::vector<std::string> fields;
+    std::stringstream sstr(model);
+    std::string field;
+    while (std::getline(sstr, field, ':'))
+    {
+        fields.push_back(field);
+    }
+    if (fields.size() < 3) {
+        throw std::invalid_argument("synthetic model needs procs:phases:io_per_phase: " + model);
+    }
+    synthetic_graph_config cfg;
+    cfg.num_procs = std::stoull(fields[0]);
+    cfg.num_phases = std::stoull(fields[1]);
+    cfg.io_per_phase = std::stoull(fields[2]);
+    if (fields.size() > 3) {
+        cfg.comm_size = std::stoull(fields[3]);
+    }
+    if (fields.size() > 4) {
+        cfg.p2p_density = std::stod(fields[4]);
+    }
+    return cfg;
+}
+
+void bench_synthetic(bench::harness& h, const std::string& model, const synthetic_graph_config& cfg)
+{
+    auto& build = h.run("synthetic/" + model + "/build", [&cfg] {
+        auto graph = make_synthetic_graph(cfg);
+        bench::do_not_optimize(graph.num_vertices());
+    });
+    auto graph = make_synthetic_graph(cfg);
+    build.counters["vertices"] = graph.num_vertices();
+    build.counters["edges"] = graph.num_edges();
+
+    h.run("synthetic/" + model + "/pio_sets", [&graph] {
+        auto sets_pp = cio_sets_per_process(graph);
+        bench::do_not_optimize(sets_pp.size());
+    });
+
+    const auto sets_pp = cio_sets_per_process(graph);
+    auto& merge = h.run("synthetic/" + model + "/cio_merge",
+        [&sets_pp] { return sets_pp; },
+        [&graph](set_map_t<VertexDescriptor>& sets) {
+            auto cio_sets = find_cio_sets(graph, sets);
+            bench::do_not_optimize(cio_sets.size());
+        });
+    auto sets_copy = sets_pp;
+    merge.counters["cio_sets"] = find_cio_sets(graph, sets_copy).size();
+}
+
+/**
+ * @brief Cost of the trace statement every event callback starts with.
+ *
+ * `compiled_out` uses a facade with info as compile-time minimum, like a
+ * release build. `runtime_filtered` keeps the statement and relies on the
+ * severity filter, like a debug build running with the default severity.
+ */
+void bench_logging(bench::harness& h)
+{
+    constexpr std::uint64_t num_events = 1000000;
+    const auto callbacks = [](auto log_facade) {
+        return [] {
+            using facade = decltype(log_facade);
+            for (std::uint64_t i = 0; i < num_events; ++i)
+            {
+                const auto ts = otf2::chrono::time_point(otf2::chrono::duration(i));
+                facade::trace() << "Found enter event to location #" << i % 64 << " @" << ts;
+                bench::do_not_optimize(i);
+            }
+        };
+    };
+
+    auto& compiled = h.run("logging/compiled_out",
+            callbacks(log::basic_logging<log::log_level::info>()));
+    compiled.counters["events"] = num_events;
+    auto& filtered = h.run("logging/runtime_filtered",
+            callbacks(log::basic_logging<log::log_level::trace>()));
+    filtered.counters["events"] = num_events;
+}
+
+void bench_module(bench::harness& h, const std::string& spec, const std::string& trace)
+{
+    // name=path/to/executable
+    const auto eq = spec.find('=');
+    const auto name = eq == std::string::npos ? spec : spec.substr(0, eq);
+    const auto path = eq == std::string::npos ? spec : spec.substr(eq + 1);
+    const auto cmd = path + " " + trace + " > /dev/null 2>&1";
+
+    // status of the last timed run, the module is not run once more for it
+    int status = 0;
+    auto& res = h.run("module/" + name, [&cmd, &status] {
+        status = std::system(cmd.c_str());
+        bench::do_not_optimize(status);
+    });
+    res.counters["exit_status"] = status;
+}
+
+std::string now_string()
+{
+    const auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream sstr;
+    sstr << std::put_time(std::localtime(&time), "%FT%T");
+    return sstr.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> traces;
+    std::vector<std::string> modules;
+    std::vector<std::string> models;
+    std::string json_file;
+    std::string label;
+    std::size_t min_iterations = 3;
+    double min_time = 1.0;
+    bool compact_io = false;
+    bool with_logging = false;
+
+    po::options_description description("rabbitxx_bench - Stage-level benchmarks");
+
+    // clang-format off
+    description.add_options()
+        ("help,h", "Display help message")
+        ("trace,t",
+            po::value<std::vector<std::string>>(&traces)->composing(),
+            "Input trace file *.otf2, can be given multiple times")
+        ("module,m",
+            po::value<std::vector<std::string>>(&modules)->composing(),
+            "Benchmark a module executable on the first trace, given as name=path")
+        ("synthetic,s",
+            po::value<std::vector<std::string>>(&models)->composing(),
+            "Benchmark an in-memory graph, given as procs:phases:io_per_phase[:comm_size[:p2p_density]]")
+        ("json,j",
+            po::value<std::string>(&json_file),
+            "Write results as json into the given file, {label} is replaced by the label")
+        ("label,l",
+            po::value<std::string>(&label)->default_value(RABBITXX_BENCH_REVISION),
+            "Label stored with the results, defaults to the git revision of the build")
+        ("min-iterations",
+            po::value<std::size_t>(&min_iterations)->default_value(3),
+            "Minimal number of iterations per benchmark")
+        ("min-time",
+            po::value<double>(&min_time)->default_value(1.0),
+            "Minimal measured time per benchmark in seconds")
+        ("logging",
+            po::bool_switch(&with_logging)->default_value(false),
+            "Benchmark log statements compiled out vs. filtered at runtime")
+        ("compact-io",
+            po::bool_switch(&compact_io)->default_value(false),
+            "Build the graph with compacted I/O events")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+        std::cerr << description;
+        return EXIT_SUCCESS;
+    }
+
+    // validate all options before the first benchmark runs
+    if (!modules.empty() && traces.empty())
+    {
+        std::cerr << "modules need a trace\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<synthetic_graph_config> model_configs;
+    for (const auto& model : models)
+    {
+        try
+        {
+            model_configs.push_back(parse_model(model));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "invalid synthetic model " << model << ": " << e.what() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    log::set_min_severity_level(nitro::log::severity_level::error);
+
+    graph::builder_config config;
+    config.compact_io = compact_io;
+
+    bench::harness h(min_iterations, std::chrono::duration<double>(min_time));
+    for (const auto& trace : traces)
+    {
+        bench_trace(h, trace, config);
+    }
+    if (with_logging)
+    {
+        bench_logging(h);
+    }
+    for (std::size_t i = 0; i < models.size(); ++i)
+    {
+        bench_synthetic(h, models[i], model_configs[i]);
+    }
+    for (const auto& module : modules)
+    {
+        bench_module(h, module, traces.front());
+    }
+
+    h.print(std::cout);
+    if (!json_file.empty())
+    {
+        const auto placeholder = json_file.find("{label}");
+        if (placeholder != std::string::npos) {
+            json_file.replace(placeholder, std::string("{label}").size(), label);
+        }
+        std::ofstream out(json_file);
+        h.write_json(out, { { "date", now_string() },
+                            { "label", label },
+                            { "compact_io", compact_io ? "true" : "false" },
+                            { "log_min_level", std::to_string(static_cast<int>(logging::min_level)) } });
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+# Write the git revision of SOURCE_DIR as RABBITXX_BENCH_REVISION into OUTPUT.
+# Runs at build time, so the benchmark label follows every commit without
+# reconfiguring. OUTPUT is only touched if the revision changed.
+execute_process(COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE revision
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+if (NOT revision)
+    set(revision "unknown")
+endif()
+
+set(content "#define RABBITXX_BENCH_REVISION \"${revision}\"\n")
+set(old_content "")
+if (EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} old_content)
+endif()
+if (NOT "${content}" STREQUAL "${old_content}")
+    file(WRITE ${OUTPUT} "${content}")
+endif()
@@ -0,0 +1,76 @@
+#ifndef RABBITXX_ANALYSIS_ACCESS_PATTERN_HPP
+#define RABBITXX_ANALYSIS_ACCESS_PATTERN_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Shape of the offsets of an access stream.
+ *
+ * contiguous:     every access starts where the previous one ended
+ * strided:        the offsets advance by a fixed stride
+ * nested_strided: a fixed number of accesses with an inner stride, followed
+ *                 by one jump with an outer stride, e.g. a 2d sub-array
+ * random:         none of the above
+ */
+enum class access_pattern
+{
+    contiguous,
+    strided,
+    nested_strided,
+    random
+};
+
+const char* to_string(access_pattern pattern);
+
+std::ostream& operator<<(std::ostream& os, access_pattern pattern);
+
+/**
+ * @brief Classification of the reads and writes of one process to one file.
+ */
+struct stream_pattern
+{
+    std::uint64_t proc_id = 0;
+    std::string filename;
+    access_pattern pattern = access_pattern::contiguous;
+    std::uint64_t num_ops = 0;
+    std::uint64_t bytes = 0;
+    // offset difference of consecutive accesses, the inner stride of a
+    // nested strided stream
+    std::int64_t stride = 0;
+    // only set on nested strided streams
+    std::int64_t outer_stride = 0;
+    std::uint64_t inner_count = 0;
+    // fraction of the accesses starting where the previous one ended
+    double contiguity = 1.0;
+    std::uint64_t min_size = 0;
+    std::uint64_t max_size = 0;
+    // number of requests per size class, the key is the smallest power of two
+    // greater than or equal to the request size
+    std::map<std::uint64_t, std::uint64_t> size_histogram;
+};
+
+std::ostream& operator<<(std::ostream& os, const stream_pattern& stream);
+
+/**
+ * @brief Classify the access stream of every (process, file) pair in `cio_set`.
+ *
+ * One pass over the set, the vertices of a process are in chronological order
+ * since they are created in that order. Only reads and writes are considered.
+ *
+ * @return One entry per stream, ordered by process id and file name.
+ */
+std::vector<stream_pattern> classify_access_patterns(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_ACCESS_PATTERN_HPP
@@ -0,0 +1,89 @@
+#ifndef RABBITXX_ANALYSIS_ALIGNMENT_HPP
+#define RABBITXX_ANALYSIS_ALIGNMENT_HPP
+
+#include <rabbitxx/analysis/false_sharing.hpp>
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Parameters of the alignment analysis.
+ *
+ * Requests are aligned if their offset is a multiple of the block size of
+ * their file system, and small if they are smaller than one block.
+ */
+struct alignment_config
+{
+    stripe_config layouts = default_stripe_config();
+    // size of the aggregation buffers, 0 uses the block size
+    std::uint64_t buffer_size = 0;
+    // a stream is flagged if at least this fraction of its requests is small
+    // and unaligned
+    double small_unaligned_fraction = 0.5;
+};
+
+/**
+ * @brief Request sizes and alignment of the reads and writes to one file.
+ */
+struct file_alignment
+{
+    std::string filename;
+    std::string file_system;
+    std::uint64_t block_size = 0;
+    std::uint64_t buffer_size = 0;
+    std::uint64_t num_ops = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t aligned_ops = 0;
+    std::uint64_t small_ops = 0;
+    std::uint64_t small_unaligned_ops = 0;
+    // number of requests per size class, the smallest power of two greater
+    // than or equal to the size
+    std::map<std::uint64_t, std::uint64_t> size_histogram;
+    // number of requests per alignment, the largest power of two dividing the
+    // offset, at most the block size
+    std::map<std::uint64_t, std::uint64_t> alignment_histogram;
+    // processes mostly issuing small unaligned requests to this file
+    std::vector<std::uint64_t> flagged_procs;
+    // sum of the recorded durations
+    otf2::chrono::duration io_time {0};
+    // requests and time if every process had aggregated its requests into
+    // aligned buffers of `buffer_size`
+    std::uint64_t aggregated_ops = 0;
+    otf2::chrono::duration aggregated_time {0};
+
+    std::uint64_t saved_ops() const noexcept
+    {
+        return num_ops > aggregated_ops ? num_ops - aggregated_ops : 0;
+    }
+
+    otf2::chrono::duration saved_time() const noexcept
+    {
+        return io_time > aggregated_time ? io_time - aggregated_time : otf2::chrono::duration(0);
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const file_alignment& file);
+
+/**
+ * @brief Request size and alignment histograms per file of `cio_set`.
+ *
+ * The time of the aggregated requests is estimated from a per-file linear
+ * model, latency plus bytes over bandwidth, fitted to the recorded
+ * `iop_duration`s in the same single pass over the set.
+ *
+ * @return One entry per file with at least one read or write, ordered by name.
+ */
+std::vector<file_alignment> analyze_alignment(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set,
+        const alignment_config& config = alignment_config());
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_ALIGNMENT_HPP
@@ -0,0 +1,89 @@
+#ifndef RABBITXX_ANALYSIS_BANDWIDTH_HPP
+#define RABBITXX_ANALYSIS_BANDWIDTH_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Time an I/O operation was in flight.
+ */
+struct busy_interval
+{
+    otf2::chrono::time_point begin;
+    otf2::chrono::time_point end;
+};
+
+/**
+ * @brief Length of the union of `intervals`, which must be sorted by begin.
+ */
+otf2::chrono::duration union_length(const std::vector<busy_interval>& intervals);
+
+/**
+ * @brief Length of the union of `intervals`, sorts them first.
+ */
+otf2::chrono::duration busy_time(std::vector<busy_interval> intervals);
+
+/**
+ * @brief Bytes transferred and the time at least one transfer was in flight.
+ */
+struct effective_bandwidth
+{
+    std::uint64_t bytes = 0;
+    otf2::chrono::duration busy_time {0};
+
+    // in bytes per second
+    double bandwidth() const
+    {
+        const auto secs = std::chrono::duration<double>(busy_time).count();
+        return secs > 0.0 ? bytes / secs : 0.0;
+    }
+};
+
+/**
+ * @brief Distribution of the effective bandwidth of the processes, in bytes
+ * per second.
+ */
+struct bandwidth_distribution
+{
+    std::uint64_t num_procs = 0;
+    double min = 0.0;
+    double median = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+};
+
+/**
+ * @brief Aggregate throughput of the reads and writes of one CIO set.
+ */
+struct set_bandwidth
+{
+    effective_bandwidth total;
+    std::map<std::string, effective_bandwidth> per_file;
+    // files without file system information are only part of `total`
+    std::map<std::string, effective_bandwidth> per_fs;
+    bandwidth_distribution per_process;
+};
+
+std::ostream& operator<<(std::ostream& os, const set_bandwidth& bw);
+
+/**
+ * @brief Effective bandwidth of `cio_set` as the bytes read and written
+ * divided by the union of the intervals of these operations, overall, per
+ * file, per file system and per process.
+ *
+ * The intervals are sorted once, the unions of the subsets are computed in a
+ * linear pass each over the sorted order.
+ */
+set_bandwidth analyze_bandwidth(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_BANDWIDTH_HPP
@@ -0,0 +1,94 @@
+#ifndef RABBITXX_ANALYSIS_CHURN_HPP
+#define RABBITXX_ANALYSIS_CHURN_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Open/close cycles and the split of the I/O time into data and
+ * metadata calls.
+ *
+ * A cycle starts with the first create or dup of a file on a process and
+ * ends with the close which leaves no handle to this file open. Reads and
+ * writes are data calls, all other I/O events metadata calls.
+ */
+struct churn_counts
+{
+    std::uint64_t cycles = 0;
+    // closes without a preceding create or dup in the analyzed events
+    std::uint64_t unmatched_closes = 0;
+    // cycles not closed within the analyzed events
+    std::uint64_t open_cycles = 0;
+    std::uint64_t data_ops = 0;
+    std::uint64_t metadata_ops = 0;
+    std::uint64_t bytes = 0;
+    otf2::chrono::duration data_time {0};
+    otf2::chrono::duration metadata_time {0};
+
+    double bytes_per_cycle() const noexcept
+    {
+        return cycles > 0 ? static_cast<double>(bytes) / cycles : 0.0;
+    }
+
+    double metadata_fraction() const noexcept
+    {
+        const auto total = (data_time + metadata_time).count();
+        return total > 0 ? static_cast<double>(metadata_time.count()) / total : 0.0;
+    }
+
+    churn_counts& operator+=(const churn_counts& other);
+};
+
+struct file_churn
+{
+    std::string filename;
+    churn_counts counts;
+};
+
+struct process_churn
+{
+    std::uint64_t proc_id = 0;
+    churn_counts counts;
+};
+
+/**
+ * @brief Open/close churn of a CIO set or of the whole graph.
+ */
+struct churn_summary
+{
+    churn_counts total;
+    // ordered by descending metadata time
+    std::vector<file_churn> files;
+    // ordered by process id
+    std::vector<process_churn> procs;
+    // metadata fraction of the file I/O time of the whole application
+    // according to `app_info`
+    double app_metadata_fraction = 0.0;
+    // fraction of the metadata time of the whole application spent in the
+    // analyzed events
+    double share_of_app_metadata_time = 0.0;
+};
+
+std::ostream& operator<<(std::ostream& os, const churn_summary& churn);
+
+/**
+ * @brief Pair the creates and dups with their closes per process and file in
+ * one pass over `cio_set`.
+ */
+churn_summary analyze_churn(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set);
+
+/**
+ * @brief `analyze_churn` over all I/O vertices of `graph`.
+ */
+churn_summary analyze_churn(const IoGraph& graph);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_CHURN_HPP
@@ -0,0 +1,67 @@
+#ifndef RABBITXX_ANALYSIS_CONCURRENCY_HPP
+#define RABBITXX_ANALYSIS_CONCURRENCY_HPP
+
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Concurrency of the I/O operations within one time bin.
+ *
+ * The means are weighted by time, e.g. two operations overlapping the whole
+ * bin and one overlapping half of it give a mean of 2.5 operations.
+ */
+struct concurrency_bin
+{
+    double mean_ops = 0.0;
+    std::uint64_t max_ops = 0;
+    double mean_procs = 0.0;
+    std::uint64_t max_procs = 0;
+    double mean_files = 0.0;
+    std::uint64_t max_files = 0;
+    // bytes read and written within the bin, the bytes of an operation are
+    // spread evenly over its duration
+    double bytes = 0.0;
+};
+
+/**
+ * @brief Binned concurrency of all I/O operations or of one file system.
+ */
+struct concurrency_profile
+{
+    // empty for the profile of all file systems
+    std::string file_system;
+    otf2::chrono::time_point start;
+    otf2::chrono::duration bin_width {0};
+    std::vector<concurrency_bin> bins;
+
+    // in bytes per second
+    double bandwidth(std::size_t bin) const;
+};
+
+/**
+ * @brief Print the profile as csv, one line per bin.
+ */
+std::ostream& operator<<(std::ostream& os, const concurrency_profile& profile);
+
+/**
+ * @brief Sweep over the enter and leave timestamps of all I/O vertices.
+ *
+ * The enter and leave events are sorted in parallel, each profile is built in
+ * one sweep, so the cost is O(n log n + number of bins). All profiles start
+ * at the first enter of an I/O operation, so their bins are aligned.
+ *
+ * @return The profile over all file systems, followed by one profile per file
+ * system from `app_info::file_to_fs` ordered by name.
+ */
+std::vector<concurrency_profile> concurrency_over_time(const IoGraph& graph,
+        otf2::chrono::duration bin_width);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_CONCURRENCY_HPP
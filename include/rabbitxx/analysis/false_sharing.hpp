@@ -0,0 +1,91 @@
+#ifndef RABBITXX_ANALYSIS_FALSE_SHARING_HPP
+#define RABBITXX_ANALYSIS_FALSE_SHARING_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Locking granularity of a file system.
+ *
+ * block_size:   size of a stripe or lock unit in bytes
+ * stripe_count: number of servers the units are distributed on round robin
+ */
+struct fs_layout
+{
+    std::uint64_t block_size = 1024 * 1024;
+    std::uint64_t stripe_count = 1;
+};
+
+/**
+ * @brief Layout per file system type as found in `app_info::file_to_fs`.
+ */
+struct stripe_config
+{
+    fs_layout default_layout;
+    std::map<std::string, fs_layout> per_fs;
+
+    const fs_layout& layout(const std::string& file_system) const
+    {
+        const auto it = per_fs.find(file_system);
+        return it != per_fs.end() ? it->second : default_layout;
+    }
+};
+
+/**
+ * @brief Default layouts, 1 MiB stripes on Lustre, 4 MiB blocks on GPFS and
+ * pages on every other file system.
+ */
+stripe_config default_stripe_config();
+
+/**
+ * @brief Units of one file touched by the accesses of a CIO set.
+ *
+ * All accesses of a set are concurrent, so every unit touched by more than
+ * one process is shared. A unit is conflicting if at least one of its
+ * accesses is a write, i.e. the lock has to move between the processes.
+ */
+struct file_sharing
+{
+    std::string filename;
+    std::string file_system;
+    fs_layout layout;
+    std::uint64_t num_procs = 0;
+    std::uint64_t units_touched = 0;
+    std::uint64_t shared_units = 0;
+    std::uint64_t conflicting_units = 0;
+    // largest number of processes sharing one unit
+    std::uint64_t max_sharers = 0;
+    // number of stripe servers holding at least one conflicting unit
+    std::uint64_t contended_servers = 0;
+    // lock transfers of the conflicting units, at least one per additional
+    // process and at most one per additional access
+    std::uint64_t min_lock_transfers = 0;
+    std::uint64_t max_lock_transfers = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const file_sharing& sharing);
+
+/**
+ * @brief Count the shared and conflicting units per file of `cio_set`.
+ *
+ * Each read and write contributes the range of units it touches. The ranges
+ * of a file are sorted and swept once, so it runs in O(n log n) independent of
+ * the request sizes.
+ *
+ * @return One entry per file with at least one read or write, ordered by name.
+ */
+std::vector<file_sharing> analyze_false_sharing(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set,
+        const stripe_config& config = default_stripe_config());
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_FALSE_SHARING_HPP
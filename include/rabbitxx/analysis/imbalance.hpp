@@ -0,0 +1,90 @@
+#ifndef RABBITXX_ANALYSIS_IMBALANCE_HPP
+#define RABBITXX_ANALYSIS_IMBALANCE_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief I/O of one process within a CIO set.
+ */
+struct process_load
+{
+    std::uint64_t proc_id = 0;
+    otf2::chrono::duration io_time {0};
+    std::uint64_t bytes = 0;
+    std::uint64_t num_ops = 0;
+    // completion of the last I/O operation of the process in the set
+    otf2::chrono::time_point io_end = otf2::chrono::genesis();
+    // time between the own last completion and the one of the slowest process
+    otf2::chrono::duration straggler_wait {0};
+};
+
+/**
+ * @brief I/O to one file within a CIO set.
+ */
+struct file_load
+{
+    std::string filename;
+    otf2::chrono::duration io_time {0};
+    std::uint64_t bytes = 0;
+    std::uint64_t num_ops = 0;
+};
+
+/**
+ * @brief Load balance of the I/O of one CIO set.
+ *
+ * The imbalance metrics refer to the I/O time of the processes in the set.
+ * The waiting time is attributed assuming that every process enters the
+ * closing synchronization right after its last I/O operation.
+ */
+struct set_imbalance
+{
+    // ordered by process id
+    std::vector<process_load> procs;
+    // ordered by descending I/O time
+    std::vector<file_load> files;
+    // process ids with the highest I/O time, slowest first
+    std::vector<std::uint64_t> slowest_procs;
+    // files with the highest I/O time, slowest first
+    std::vector<std::string> slowest_files;
+    double max_over_mean = 0.0;
+    double coefficient_of_variation = 0.0;
+    // sum of the straggler waits of all processes
+    otf2::chrono::duration straggler_wait {0};
+    // time spent in the synchronization ending the set, summed over the
+    // processes of the set, zero if the set is not closed by a synchronization
+    otf2::chrono::duration end_sync_time {0};
+    // part of `end_sync_time` explained by waiting for I/O stragglers,
+    // each process waits at most for its own straggler wait
+    otf2::chrono::duration end_sync_straggler_time {0};
+};
+
+std::ostream& operator<<(std::ostream& os, const set_imbalance& imbalance);
+
+/**
+ * @brief Per-process and per-file load of `cio_set` in a single pass.
+ *
+ * @param top_n number of slowest processes and files to report
+ */
+set_imbalance analyze_imbalance(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set,
+        std::size_t top_n = 3);
+
+/**
+ * @brief `analyze_imbalance` of every set, the sets are analyzed in parallel.
+ *
+ * @return One entry per set in the order of `cio_sets`.
+ */
+std::vector<set_imbalance> analyze_imbalance(const IoGraph& graph,
+        const set_container_t<VertexDescriptor>& cio_sets,
+        std::size_t top_n = 3);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_IMBALANCE_HPP
@@ -0,0 +1,82 @@
+#ifndef RABBITXX_ANALYSIS_IO_STREAM_HPP
+#define RABBITXX_ANALYSIS_IO_STREAM_HPP
+
+#include <rabbitxx/graph/otf2_io_graph_properties.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Reads and writes transfer data, all other I/O events are metadata.
+ */
+inline bool is_data_access(const io_event_property& io) noexcept
+{
+    return io.kind == io_event_kind::read || io.kind == io_event_kind::write;
+}
+
+/**
+ * @brief First byte accessed by a read or write.
+ *
+ * The builder stores the file position after the operation in `offset`.
+ */
+inline std::uint64_t begin_offset(const io_event_property& io) noexcept
+{
+    if (io.offset < io.response_size) {
+        return io.offset;
+    }
+    return io.offset - io.response_size;
+}
+
+/**
+ * @brief Time spent in the I/O operation of `vertex`.
+ *
+ * Reads and writes record the duration of the operation, all other I/O
+ * events just the duration of their region.
+ */
+inline otf2::chrono::duration operation_time(const otf2_trace_event& vertex)
+{
+    const auto& io = boost::get<io_event_property>(vertex.property);
+    return io.iop_duration ? *io.iop_duration : vertex.duration.duration;
+}
+
+/**
+ * @brief Smallest power of two greater than or equal to `size`, the size class
+ * of a request in histograms.
+ */
+inline std::uint64_t size_class(std::uint64_t size) noexcept
+{
+    std::uint64_t cls = 1;
+    while (cls < size && cls < (std::uint64_t(1) << 63)) {
+        cls <<= 1;
+    }
+    return cls;
+}
+
+/**
+ * @brief The accesses of one process to one file.
+ */
+struct stream_key
+{
+    std::uint64_t proc_id;
+    std::string filename;
+
+    bool operator==(const stream_key& other) const noexcept
+    {
+        return proc_id == other.proc_id && filename == other.filename;
+    }
+};
+
+struct stream_key_hash
+{
+    std::size_t operator()(const stream_key& key) const noexcept
+    {
+        return std::hash<std::string>()(key.filename) ^ (std::hash<std::uint64_t>()(key.proc_id) << 1);
+    }
+};
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_IO_STREAM_HPP
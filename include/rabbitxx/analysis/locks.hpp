@@ -0,0 +1,73 @@
+#ifndef RABBITXX_ANALYSIS_LOCKS_HPP
+#define RABBITXX_ANALYSIS_LOCKS_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Wait and hold times of file locks, see `io_lock_interval`.
+ *
+ * A lock is contended if it waited for a conflicting lock of another
+ * process: an exclusive lock conflicts with every lock, a shared lock with
+ * exclusive locks.
+ */
+struct lock_contention
+{
+    std::uint64_t locks = 0;
+    std::uint64_t exclusive = 0;
+    std::uint64_t shared = 0;
+    std::uint64_t contended = 0;
+    // number of processes with at least one contended lock
+    std::uint64_t contenders = 0;
+    std::uint64_t failed_tries = 0;
+    otf2::chrono::duration wait_time {0};
+    otf2::chrono::duration max_wait {0};
+    otf2::chrono::duration hold_time {0};
+    otf2::chrono::duration max_hold {0};
+
+    double contended_fraction() const noexcept
+    {
+        return locks > 0 ? static_cast<double>(contended) / locks : 0.0;
+    }
+};
+
+struct file_lock_contention
+{
+    std::string filename;
+    lock_contention contention;
+};
+
+/**
+ * @brief Lock contention of a CIO set or of the whole application.
+ */
+struct lock_summary
+{
+    lock_contention total;
+    // ordered by descending wait time
+    std::vector<file_lock_contention> files;
+};
+
+std::ostream& operator<<(std::ostream& os, const lock_summary& locks);
+
+/**
+ * @brief Contention of the `lock_intervals` of the graph properties which
+ * overlap the time span of `cio_set`, from the earliest begin to the latest
+ * end of its I/O events.
+ */
+lock_summary analyze_locks(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set);
+
+/**
+ * @brief Contention of all `locks`.
+ */
+lock_summary analyze_locks(const std::vector<io_lock_interval>& locks);
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_LOCKS_HPP
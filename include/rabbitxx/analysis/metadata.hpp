@@ -0,0 +1,154 @@
+#ifndef RABBITXX_ANALYSIS_METADATA_HPP
+#define RABBITXX_ANALYSIS_METADATA_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Trie of the directories of all files, one node per path component.
+ *
+ * Every file name is split once, afterwards the directory of a file is a
+ * single hash lookup. Relative paths hang below the root as well.
+ */
+class directory_trie
+{
+public:
+    using node_id = std::uint32_t;
+    static constexpr node_id root = 0;
+    static constexpr node_id npos = std::numeric_limits<node_id>::max();
+
+    directory_trie();
+
+    /**
+     * @brief Add the directories of `filename`, returns its directory.
+     */
+    node_id insert(const std::string& filename);
+
+    /**
+     * @brief Directory of an inserted file, `npos` for unknown files.
+     */
+    node_id directory_of(const std::string& filename) const
+    {
+        const auto it = files_.find(filename);
+        return it != files_.end() ? it->second : npos;
+    }
+
+    node_id parent(node_id node) const
+    {
+        return nodes_[node].parent;
+    }
+
+    // the root has depth 0
+    std::uint32_t depth(node_id node) const
+    {
+        return nodes_[node].depth;
+    }
+
+    /**
+     * @brief Ancestor of `node` at `depth`, or `node` if it is not deeper.
+     */
+    node_id ancestor(node_id node, std::uint32_t depth) const;
+
+    std::string path(node_id node) const;
+
+    std::size_t size() const noexcept
+    {
+        return nodes_.size();
+    }
+
+private:
+    struct trie_node
+    {
+        node_id parent;
+        std::uint32_t depth;
+        std::string name;
+        std::unordered_map<std::string, node_id> children;
+    };
+
+    std::vector<trie_node> nodes_;
+    std::unordered_map<std::string, node_id> files_;
+};
+
+/**
+ * @brief Trie of the files of all I/O vertices of `graph`.
+ */
+directory_trie make_directory_trie(const IoGraph& graph);
+
+/**
+ * @brief Parameters of the metadata analysis.
+ */
+struct metadata_config
+{
+    // length of the sliding window for the peak rates
+    otf2::chrono::duration window = std::chrono::duration_cast<otf2::chrono::duration>(
+            std::chrono::milliseconds(100));
+    // depth of the prefixes the metadata load is summed up for, e.g. the
+    // directories distributed on metadata servers by Lustre DNE
+    std::uint32_t prefix_depth = 2;
+    // directories with a higher peak rate in ops per second are storms
+    double storm_rate = 1000.0;
+};
+
+/**
+ * @brief Metadata operations on the files of one directory or prefix.
+ */
+struct directory_metadata
+{
+    std::string path;
+    std::uint64_t creates = 0;
+    std::uint64_t dups = 0;
+    std::uint64_t closes = 0;
+    // distinct processes and files with metadata operations
+    std::uint64_t num_procs = 0;
+    std::uint64_t num_files = 0;
+    // time spent in the operations
+    otf2::chrono::duration time {0};
+    // creates per second between the first and the last operation, at least
+    // over one window
+    double create_rate = 0.0;
+    // most operations within one window and the resulting rate per second
+    std::uint64_t peak_window_ops = 0;
+    double peak_rate = 0.0;
+    bool storm = false;
+
+    std::uint64_t num_ops() const noexcept
+    {
+        return creates + dups + closes;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const directory_metadata& dir);
+
+/**
+ * @brief Metadata load of one CIO set.
+ */
+struct set_metadata
+{
+    // directories with metadata operations on their files, ordered by path
+    std::vector<directory_metadata> directories;
+    // sum of the directories below each prefix, ordered by path
+    std::vector<directory_metadata> prefixes;
+};
+
+/**
+ * @brief Count the creates, dups and closes per directory and prefix of
+ * `cio_set`.
+ *
+ * Throws `std::invalid_argument` if the window of `config` is not positive.
+ */
+set_metadata analyze_metadata(const IoGraph& graph, const directory_trie& trie,
+        const set_t<VertexDescriptor>& cio_set,
+        const metadata_config& config = metadata_config());
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_METADATA_HPP
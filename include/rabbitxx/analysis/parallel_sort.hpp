@@ -0,0 +1,88 @@
+#ifndef RABBITXX_ANALYSIS_PARALLEL_SORT_HPP
+#define RABBITXX_ANALYSIS_PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace rabbitxx { namespace analysis {
+
+/**
+ * @brief Sort [first, last) with up to `std::thread::hardware_concurrency()`
+ * threads.
+ *
+ * The range is split into chunks which are sorted concurrently and merged
+ * pairwise afterwards. Small ranges are sorted sequentially.
+ */
+template<typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    constexpr std::ptrdiff_t min_chunk_size = 1 << 16;
+    const auto size = std::distance(first, last);
+    const auto max_chunks = std::max<std::ptrdiff_t>(1, std::thread::hardware_concurrency());
+    const auto num_chunks = std::min(max_chunks, size / min_chunk_size);
+    if (num_chunks < 2)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<RandomIt> bounds;
+    bounds.reserve(num_chunks + 1);
+    for (std::ptrdiff_t i = 0; i < num_chunks; ++i)
+    {
+        bounds.push_back(first + i * (size / num_chunks));
+    }
+    bounds.push_back(last);
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(num_chunks);
+    for (std::ptrdiff_t i = 0; i < num_chunks; ++i)
+    {
+        tasks.push_back(std::async(std::launch::async,
+                    [=]() { std::sort(bounds[i], bounds[i + 1], comp); }));
+    }
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    // merge neighbouring chunks until one is left
+    while (bounds.size() > 2)
+    {
+        std::vector<RandomIt> merged;
+        tasks.clear();
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2)
+        {
+            const auto lo = bounds[i];
+            const auto mid = bounds[i + 1];
+            const auto hi = bounds[i + 2];
+            tasks.push_back(std::async(std::launch::async,
+                        [=]() { std::inplace_merge(lo, mid, hi, comp); }));
+            merged.push_back(lo);
+        }
+        if (bounds.size() % 2 == 0) {
+            // odd number of chunks, the last one is merged in the next round
+            merged.push_back(bounds[bounds.size() - 2]);
+        }
+        merged.push_back(last);
+        for (auto& task : tasks)
+        {
+            task.get();
+        }
+        bounds = std::move(merged);
+    }
+}
+
+template<typename RandomIt>
+void parallel_sort(RandomIt first, RandomIt last)
+{
+    parallel_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+}} // namespace rabbitxx::analysis
+
+#endif // RABBITXX_ANALYSIS_PARALLEL_SORT_HPP
@@ -69,6 +69,20 @@ std::vector<VertexDescriptor> get_io_events_by_kind(const IoGraph& graph,
 std::vector<VertexDescriptor>
 get_io_events_by_kind(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set, const std::vector<io_event_kind>& kinds);
 
+/**
+ * The paradigms of all I/O events, i.e. the I/O layers of the graph.
+ */
+std::set<std::string> io_layers(const IoGraph& graph);
+
+/**
+ * Keep just the I/O events of `paradigm` in the sets per process.
+ * The set boundaries are given by the synchronizations, so restricting the
+ * sets per process before merging yields the CIO-Sets of one layer of a
+ * graph built with `keep_all_layers`.
+ */
+void restrict_to_layer(const IoGraph& graph, set_map_t<VertexDescriptor>& sets,
+        const std::string& paradigm);
+
 namespace detail
 {
 
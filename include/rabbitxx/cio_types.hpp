@@ -139,6 +139,11 @@ public:
         return set_.insert(value);
     }
 
+    size_type erase(const value_type& value)
+    {
+        return set_.erase(value);
+    }
+
     iterator begin() noexcept
     {
         return set_.begin();
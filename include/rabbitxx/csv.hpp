@@ -0,0 +1,48 @@
+#ifndef RABBITXX_CSV_HPP
+#define RABBITXX_CSV_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace rabbitxx
+{
+
+// get microseconds as floating point values
+using FpMicroseconds = std::chrono::duration<double, std::micro>;
+// get milliseconds as floating point values
+using FpMilliseconds = std::chrono::duration<double, std::milli>;
+// get seconds as floating point values
+using FpSeconds = std::chrono::duration<double>;
+
+/**
+ * @brief Bandwidth of an I/O operation in MiB/s.
+ *
+ * @return 0.0 if the response size is unknown.
+ */
+double calculate_bandwidth(const io_event_property& io_evt);
+
+/**
+ * @brief Write the column names of the I/O event csv format.
+ */
+void csv_header(std::ostream& os = std::cout);
+
+// TODO do that also for other options
+std::string get_option(const io_event_property& io_evt);
+
+/**
+ * @brief Write one I/O event as csv row, without the trailing newline.
+ */
+std::ostream& io_event_2_csv_stream(const IoGraph& graph, const VertexDescriptor& evt, std::ostream& out);
+
+/**
+ * @brief Write all I/O events of a set as csv including the header.
+ */
+void set2csv(const IoGraph& graph, const set_t<VertexDescriptor>& set, std::ostream& out = std::cout);
+
+} // namespace rabbitxx
+
+#endif // RABBITXX_CSV_HPP
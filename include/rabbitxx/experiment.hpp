@@ -3,6 +3,7 @@
 
 #include <rabbitxx/graph.hpp>
 #include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/profiler.hpp>
 #include <rabbitxx/stats.hpp>
 #include <rabbitxx/utils.hpp>
 #include <functional>
@@ -33,13 +34,19 @@ struct experiment_config
     bool with_summary = true;
     bool pio_sets = false;
     bool cio_sets = true;
+    // If not empty, the sets hold just the I/O of this paradigm, see
+    // `builder_config::keep_all_layers`.
+    std::string layer {};
+    graph::builder_config builder {};
 };
 
 inline std::ostream& operator<<(std::ostream& os, const experiment_config& ec)
 {
     os << std::boolalpha << "with_summary: " << ec.with_summary
         << "pio_set: " << ec.pio_sets
-        << "cio_set: " << ec.cio_sets;
+        << "cio_set: " << ec.cio_sets
+        << "layer: " << ec.layer
+        << "builder: " << ec.builder;
     return os;
 }
 
@@ -0,0 +1,88 @@
+#ifndef RABBITXX_FILTER_HPP
+#define RABBITXX_FILTER_HPP
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace rabbitxx
+{
+
+/**
+ * @brief Character trie holding path prefixes.
+ *
+ * A path matches if one of the inserted prefixes is a prefix of it, which is
+ * the same semantic as `str.startswith` in the python filters.
+ * The lookup costs O(length of the path) independent of the number of prefixes.
+ */
+class path_trie
+{
+public:
+    path_trie();
+
+    void insert(const std::string& prefix);
+
+    bool matches_prefix(const std::string& path) const;
+
+    bool empty() const noexcept
+    {
+        return num_prefixes_ == 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return num_prefixes_;
+    }
+
+private:
+    struct node
+    {
+        std::map<char, std::size_t> children;
+        bool terminal = false;
+    };
+
+    std::vector<node> nodes_;
+    std::size_t num_prefixes_ = 0;
+};
+
+/**
+ * @brief Specification which I/O handles, paradigms and regions are dropped during
+ * graph construction.
+ *
+ * The builder compiles the specification into lookup tables indexed by the
+ * OTF2 definition references, so filtered events are rejected in O(1).
+ */
+struct filter_spec
+{
+    // paths starting with one of these prefixes are dropped
+    path_trie excluded_paths;
+    // if not empty, only I/O of these paradigms is kept
+    std::set<std::string> allowed_paradigms;
+    // I/O of these paradigms is dropped, by default we are just interested in POSIX I/O
+    std::set<std::string> excluded_paradigms { "MPI-IO" };
+    // if not empty, only events within these regions, or regions called from them, are kept
+    std::set<std::string> included_regions;
+    // events within these regions, or regions called from them, are dropped
+    std::set<std::string> excluded_regions;
+
+    /**
+     * @brief Create the default filter extended by the pseudo files and
+     * software trees which are removed by `scripts/analysis/Filter.py`.
+     */
+    static filter_spec pseudo_files();
+
+    bool is_paradigm_filtered(const std::string& paradigm) const;
+
+    bool is_path_filtered(const std::string& path) const;
+
+    bool is_region_filtered(const std::string& region) const;
+};
+
+std::ostream& operator<<(std::ostream& os, const filter_spec& spec);
+
+} // namespace rabbitxx
+
+#endif // RABBITXX_FILTER_HPP
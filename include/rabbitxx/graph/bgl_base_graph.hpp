@@ -6,6 +6,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <type_traits>
 
 namespace rabbitxx { namespace graph {
 
@@ -40,12 +41,32 @@ namespace rabbitxx { namespace graph {
                 return graph_.get();
             }
 
+            const GraphImpl* get() const noexcept
+            {
+                return graph_.get();
+            }
+
             vertex_descriptor add_vertex(const vertex_type& v)
             {
                 const auto vd = boost::add_vertex(v, *graph_);
                 return vd;
             }
 
+            /**
+             * @brief Reserve storage for at least `n` vertices, to avoid
+             * repeated reallocation of the vertex vector while building.
+             */
+            void reserve(std::size_t n)
+            {
+                // boost::adjacency_list has no public reserve. With vecS vertex
+                // storage, the vertices are the std::vector `m_vertices`, an
+                // undocumented member of boost's implementation. This is the
+                // only place that relies on it, revisit on boost updates.
+                static_assert(std::is_same<typename GraphImpl::vertex_list_selector, boost::vecS>::value,
+                              "reserve needs vecS vertex storage");
+                graph_->m_vertices.reserve(n);
+            }
+
             edge_t add_edge(const vertex_descriptor& vd_from,
                                 const vertex_descriptor& vd_to)
             {
@@ -107,7 +128,7 @@ namespace rabbitxx { namespace graph {
                 return graph_->operator[](vd);
             }
 
-            graph_property_type graph_properties() const
+            const graph_property_type& graph_properties() const
             {
                 return graph_->operator[](boost::graph_bundle);
             }
@@ -0,0 +1,186 @@
+#ifndef RABBITXX_GRAPH_SIZE_ESTIMATE_HPP
+#define RABBITXX_GRAPH_SIZE_ESTIMATE_HPP
+
+#include <otf2xx/definition/definitions.hpp>
+#include <otf2xx/event/events.hpp>
+#include <otf2xx/reader/reader.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx { namespace graph {
+
+struct builder_config;
+
+/**
+ * How the number of vertices is estimated before the events are read.
+ *
+ * none:        No estimate, the graph grows one vertex at a time.
+ * definitions: Upper bound from the per-location event counts stored in the
+ *              location definitions, no additional pass over the events.
+ * count:       Full second read of all events of the selected locations
+ *              before the graph is built, which roughly doubles the reading
+ *              time. Counts the events that create vertices within the
+ *              window and without filtered handles, the region filter is not
+ *              applied.
+ */
+enum class presize_mode
+{
+    none,
+    definitions,
+    count
+};
+
+std::ostream& operator<<(std::ostream& os, const presize_mode mode);
+
+struct location_estimate
+{
+    // number of events recorded for the location
+    std::uint64_t num_events = 0;
+    // expected number of I/O vertices
+    std::uint64_t io_vertices = 0;
+    // expected number of synchronization vertices
+    std::uint64_t sync_vertices = 0;
+};
+
+/**
+ * @brief Estimated size of an I/O graph, before it is build.
+ */
+struct graph_size_estimate
+{
+    presize_mode mode = presize_mode::none;
+    std::map<std::uint64_t, location_estimate> locations;
+
+    std::uint64_t num_events() const noexcept;
+
+    std::uint64_t num_io_vertices() const noexcept;
+
+    std::uint64_t num_sync_vertices() const noexcept;
+
+    /**
+     * @brief Number of vertices including the synthetic root and end vertex.
+     */
+    std::uint64_t num_vertices() const noexcept;
+
+    /**
+     * @brief Approximate memory consumption of one vertex in bytes.
+     */
+    static std::uint64_t vertex_bytes() noexcept;
+
+    /**
+     * @brief Approximate memory consumption of the graph in bytes.
+     *
+     * Takes the vertex storage, the out-edge lists and the heap memory of the
+     * string properties into account.
+     */
+    std::uint64_t memory_bytes() const noexcept;
+};
+
+std::ostream& operator<<(std::ostream& os, const graph_size_estimate& est);
+
+/**
+ * @brief Estimate the graph size from the location definitions.
+ *
+ * Each vertex is created from at least three events, the enter and leave of
+ * the surrounding region and the I/O or MPI event itself. So a third of the
+ * events of a location is an upper bound for the number of vertices. Since
+ * the definitions do not tell I/O and MPI apart, all vertices are accounted
+ * as I/O vertices.
+ *
+ * The definitions must have been read before.
+ */
+graph_size_estimate estimate_from_definitions(const otf2::reader::reader& rdr);
+
+/**
+ * @brief Callback counting the events, which create a vertex in the
+ * `io_graph_builder`, per location.
+ */
+class event_counter : public otf2::reader::callback
+{
+public:
+    event_counter() = default;
+
+    /**
+     * @brief Count only the events the builder would turn into vertices with
+     * `config`, i.e. of the selected locations, within the window and
+     * without filtered handles. `config` must outlive the counter.
+     */
+    explicit event_counter(const builder_config& config) : config_(&config)
+    {
+    }
+
+    graph_size_estimate estimate() const
+    {
+        return estimate_;
+    }
+
+    void event(const otf2::definition::location& location,
+                const otf2::event::enter& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::leave& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_operation_complete& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_create_handle& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_delete_file& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_destroy_handle& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_duplicate_handle& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::io_seek& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::mpi_collective_end& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::mpi_ireceive& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::mpi_isend& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::mpi_receive& evt) override;
+    void event(const otf2::definition::location& location,
+                const otf2::event::mpi_send& evt) override;
+
+    void definitions_done(const otf2::reader::reader& rdr) override;
+
+private:
+    location_estimate& at(const otf2::definition::location& location)
+    {
+        return estimate_.locations[location.ref()];
+    }
+
+    bool in_window(otf2::chrono::time_point tp) const;
+
+    bool is_filtered(const otf2::definition::io_handle& handle) const;
+
+    const builder_config* config_ = nullptr;
+    // handles dropped by the filter of `config_`, indexed by reference
+    std::vector<bool> filtered_handles_ {};
+    graph_size_estimate estimate_ {};
+};
+
+/**
+ * @brief Estimate the graph size of a trace file.
+ *
+ * @param trace_file: Path to the otf2 anchor file.
+ * @param mode: `presize_mode::count` reads all events once more, otherwise
+ * only the definitions are read.
+ */
+graph_size_estimate estimate_graph_size(const std::string& trace_file, presize_mode mode);
+
+/**
+ * @brief Estimate the graph size the builder creates with `config`, using
+ * `config.presize` as mode.
+ *
+ * Only the selected locations are estimated. The count mode applies the
+ * window and the handle filters, the definitions mode can not and stays an
+ * upper bound.
+ */
+graph_size_estimate estimate_graph_size(const std::string& trace_file, const builder_config& config);
+
+}} // namespace rabbitxx::graph
+
+#endif // RABBITXX_GRAPH_SIZE_ESTIMATE_HPP
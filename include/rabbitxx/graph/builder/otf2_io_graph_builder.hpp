@@ -3,8 +3,13 @@
 
 #include <rabbitxx/trace/base.hpp>
 #include <rabbitxx/graph/io_graph.hpp>
+#include <rabbitxx/graph/ingestion_stats.hpp>
+#include <rabbitxx/graph/builder/graph_size_estimate.hpp>
+#include <rabbitxx/graph/builder/sync_matching.hpp>
 #include <rabbitxx/mapping.hpp>
 #include <rabbitxx/location_queue.hpp>
+#include <rabbitxx/filter.hpp>
+#include <rabbitxx/profiler.hpp>
 
 #include <otf2xx/definition/definitions.hpp>
 #include <otf2xx/event/events.hpp>
@@ -12,6 +17,13 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
 namespace rabbitxx { namespace graph {
 
 struct stack_frame
@@ -27,6 +39,115 @@ struct stack_frame
 };
 
 
+/**
+ * An I/O operation is identified by its handle and matching id, completions
+ * of non-blocking operations may arrive in any order.
+ */
+struct io_operation_key
+{
+    std::uint64_t handle;
+    std::uint64_t matching_id;
+
+    bool operator==(const io_operation_key& other) const noexcept
+    {
+        return handle == other.handle && matching_id == other.matching_id;
+    }
+};
+
+struct io_operation_key_hash
+{
+    std::size_t operator()(const io_operation_key& key) const noexcept
+    {
+        return std::hash<std::uint64_t>()(key.handle) ^ (std::hash<std::uint64_t>()(key.matching_id) << 1);
+    }
+};
+
+/**
+ * An I/O operation which has begun, but is not completed yet.
+ */
+struct pending_io_operation
+{
+    otf2::event::io_operation_begin begin;
+    // region of the begin event, the completion of a non-blocking operation
+    // happens in a different region, e.g. aio_return or MPI_Wait
+    std::string region_name;
+    // only set for non-blocking operations
+    boost::optional<otf2::chrono::time_point> issued;
+    std::uint64_t num_tests = 0;
+    // file position of the handle at the begin
+    std::uint64_t offset_begin = 0;
+    // communicator of the handle if this is part of a collective I/O call
+    std::uint64_t collective_comm = std::numeric_limits<std::uint64_t>::max();
+    // vertices of the operations on child handles within this one, e.g. the
+    // POSIX writes of an MPI-IO write, they complete first
+    std::vector<VertexDescriptor> children;
+};
+
+/**
+ * A non-blocking point-to-point request which is not completed yet.
+ * The synchronization takes place at the completion, e.g. in MPI_Wait.
+ */
+struct pending_request
+{
+    // set for sends, the data of receives is known at their completion
+    boost::optional<peer2peer> op;
+    otf2::chrono::time_point issued;
+};
+
+/**
+ * A lock is identified by its handle and type, a shared and an exclusive lock
+ * of the same handle are held independently.
+ */
+struct lock_key
+{
+    std::uint64_t handle;
+    otf2::common::lock_type type;
+
+    bool operator==(const lock_key& other) const noexcept
+    {
+        return handle == other.handle && type == other.type;
+    }
+};
+
+struct lock_key_hash
+{
+    std::size_t operator()(const lock_key& key) const noexcept
+    {
+        return std::hash<std::uint64_t>()(key.handle) ^ (static_cast<std::size_t>(key.type) << 1);
+    }
+};
+
+/**
+ * A lock which is acquired, but not released yet.
+ */
+struct held_lock
+{
+    io_lock_interval interval;
+    // number of nested acquisitions, the lock is released with the outermost
+    std::uint64_t depth = 1;
+};
+
+/**
+ * Unsuccessful io_try_lock events of a lock since its last acquisition.
+ */
+struct lock_attempts
+{
+    std::uint64_t count = 0;
+    // region enter of the first try
+    otf2::chrono::time_point first;
+    otf2::chrono::time_point last;
+};
+
+/**
+ * Region filter state of a call stack frame. A region called from an
+ * included or excluded region is within it as well.
+ */
+struct region_scope
+{
+    bool included = false;
+    bool excluded = false;
+};
+
 struct offset_tracker
 {
     uint64_t get() const
@@ -55,6 +176,59 @@ private:
 };
 
 
+/**
+ * Options controlling the construction of the I/O graph.
+ */
+struct builder_config
+{
+    // Fold runs of back-to-back reads or writes of one location on the same
+    // file into a single vertex, see `io_range`.
+    bool compact_io = false;
+    // I/O events dropped before any vertex is created
+    filter_spec filter {};
+    // Only events within [window_begin, window_end] are turned into vertices.
+    // The synthetic root and end vertex are placed at the window edges.
+    otf2::chrono::time_point window_begin = otf2::chrono::genesis();
+    otf2::chrono::time_point window_end = otf2::chrono::armageddon();
+    // If not empty, only the events of these locations are read. Process ids
+    // are renumbered densely, `app_info::locations` maps them back.
+    std::set<std::uint64_t> locations {};
+    // Estimate the number of vertices before reading the events and reserve
+    // the graph storage up front. `presize_mode::count` reads all events of
+    // the selected locations twice, which roughly doubles the reading time.
+    presize_mode presize = presize_mode::none;
+    // Upper bound of the memory reserved up front in MiB, the estimate of
+    // `presize_mode::definitions` is a loose upper bound. The graph still
+    // grows beyond the reserved size if needed.
+    std::uint64_t presize_budget_mib = 1024;
+    // Log the ingestion progress with the estimated time remaining every
+    // `progress_interval` seconds, 0 disables the reports.
+    double progress_interval = 0.0;
+    // Keep the I/O of every paradigm layer, e.g. HDF5, MPI-IO and POSIX, in
+    // one graph. The paradigm filter is not applied and handles with a parent
+    // are kept, their vertices link to the parent handle via `parent_event`.
+    // Use `restrict_to_layer` to compute the sets of a single layer.
+    bool keep_all_layers = false;
+    // Add one vertex per collective I/O call, e.g. MPI_File_write_all, with
+    // an edge to the I/O vertex of each participating process. Every process
+    // keeps its own vertex, which refers to the call by `collective_event`.
+    // Requires the paradigm, e.g. MPI-IO, not to be filtered.
+    bool aggregate_collective_io = false;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const builder_config& conf)
+{
+    os << std::boolalpha << "compact_io: " << conf.compact_io
+        << " filter: " << conf.filter
+        << " window: [" << conf.window_begin << ", " << conf.window_end << "]"
+        << " locations: " << conf.locations.size()
+        << " presize: " << conf.presize << " (" << conf.presize_budget_mib << " MiB)"
+        << " progress interval: " << conf.progress_interval
+        << " keep all layers: " << conf.keep_all_layers
+        << " aggregate collective I/O: " << conf.aggregate_collective_io;
+    return os;
+}
+
 class io_graph_builder : public rabbitxx::trace::base
 {
     typedef rabbitxx::trace::base base;
@@ -62,17 +236,19 @@ class io_graph_builder : public rabbitxx::trace::base
 public:
     using otf2::reader::callback::event;
     using otf2::reader::callback::definition;
-    using mapping_type = mapping<rabbitxx::detail::round_robin_mapping>;
+    using mapping_type = mapping<rabbitxx::detail::weighted_greedy_mapping>;
 
-    explicit io_graph_builder(boost::mpi::communicator& comm, int num_locations)
-    : base(comm), io_ops_started_(), mapping_(comm.size(), num_locations),
+    explicit io_graph_builder(boost::mpi::communicator& comm, int num_locations,
+                                const builder_config& config = builder_config())
+    : base(comm), config_(config), io_ops_started_(), mapping_(comm.size(), num_locations),
         edge_points_(), region_name_queue_(), synchronizations_(), graph_(),
         root_(create_synthetic_root())
     {
     }
 
-    explicit io_graph_builder(int num_locations)
-    : base(), io_ops_started_(), mapping_(num_locations),
+    explicit io_graph_builder(int num_locations,
+                                const builder_config& config = builder_config())
+    : base(), config_(config), io_ops_started_(), mapping_(num_locations),
         edge_points_(), region_name_queue_(), synchronizations_(), graph_(),
         root_(create_synthetic_root())
     {
@@ -83,6 +259,12 @@ public:
         return std::move(graph_);
     }
 
+    /**
+     * @brief Reserve the graph storage for the estimated number of vertices
+     * of the selected locations, at most `config.presize_budget_mib`.
+     */
+    void reserve(const graph_size_estimate& estimate);
+
     /**
         * @brief Return the mapping object. This is mainly used for debugging.
         */
@@ -110,9 +292,133 @@ private:
 
     void check_time(otf2::chrono::time_point tp);
 
+    bool has_window() const noexcept;
+
+    bool in_window(otf2::chrono::time_point tp) const noexcept;
+
+    bool is_selected(std::uint64_t location_ref) const;
+
+    /**
+        * @brief Whether just a part of the trace is read, in which case
+        * synchronizations may miss their counterpart.
+        */
+    bool is_partial() const noexcept;
+
+    /**
+        * @brief Renumber the process ids of all vertices densely, if just a
+        * subset of the locations was read. This is necessary since the set
+        * algorithms assume process ids in [0, num_locations).
+        */
+    void remap_process_ids();
+
+    /**
+        * @brief Try to fold a completed read or write operation into the last
+        * vertex of the location.
+        *
+        * Folding is only possible if the last vertex is a read or write of the
+        * same kind, on the same file, from the same region and ends exactly
+        * where the new operation starts.
+        *
+        * @return true if the operation was folded, false if a new vertex is needed.
+        */
+    bool fold_io_operation(const otf2::definition::location& location,
+                            const io_event_property& io_op,
+                            std::uint64_t offset_begin);
+
+    /**
+        * @brief The pending operation of `handle` with `matching_id`, or nullptr
+        * if its begin has not been recorded, e.g. it began before the window.
+        */
+    pending_io_operation* find_io_operation(const otf2::definition::location& location,
+                                            const otf2::definition::io_handle& handle,
+                                            std::uint64_t matching_id);
+
     //FIXME: get_io_handle_name would be a better name since we actually work on a `io_handle`.
     std::string get_handle_name(const otf2::definition::io_handle& handle) const;
 
+    /**
+        * @brief File position of `handle` on `location`. Handles opened before
+        * the trace starts get a position at offset 0 on first use.
+        */
+    offset_tracker& file_position(const otf2::definition::location& location,
+                                    const otf2::definition::io_handle& handle);
+
+    /**
+        * @brief Start holding the lock of `handle` with `type`, consumes the
+        * unsuccessful tries of this lock.
+        */
+    held_lock& hold_lock(const otf2::definition::location& location,
+                            const otf2::definition::io_handle& handle,
+                            otf2::common::lock_type type,
+                            otf2::chrono::time_point requested,
+                            otf2::chrono::time_point acquired);
+
+    /**
+        * @brief Store the interval of the held lock `key` as released at `tp`.
+        *
+        * @return false if the lock is not held, e.g. it was acquired before
+        * the window.
+        */
+    bool release_lock(const otf2::definition::location& location,
+                        const lock_key& key,
+                        otf2::chrono::time_point tp);
+
+    /**
+        * @brief Remember `vd` as the latest vertex of `handle` and link it and
+        * `children` to each other, if all layers are kept.
+        *
+        * `vd` is linked to the operation of the parent handle in flight, when
+        * that completes, or else to the latest vertex of the parent handle.
+        */
+    void link_layers(const otf2::definition::location& location,
+                        const otf2::definition::io_handle& handle,
+                        VertexDescriptor vd,
+                        const std::vector<VertexDescriptor>& children = {});
+
+    /**
+        * @brief Remember the selected members of `comm`, the participants of
+        * the collective I/O calls on its handles.
+        *
+        * @return The reference of `comm`.
+        */
+    std::uint64_t collective_io_comm(const otf2::definition::comm& comm);
+
+    /**
+        * @brief Compile `config_.filter` into lookup tables indexed by the
+        * definition references, called once in `definitions_done`.
+        */
+    void compile_filter(const otf2::reader::reader& rdr);
+
+    /**
+        * @brief Check whether I/O events on `handle` or within the regions
+        * on the call stack of `location` are filtered. O(1) table lookups only.
+        */
+    bool is_filtered(const otf2::definition::location& location,
+                        const otf2::definition::io_handle& handle);
+
+    bool is_filtered(const otf2::definition::location& location,
+                        const otf2::definition::io_paradigm& paradigm,
+                        const otf2::definition::io_file& file);
+
+    /**
+        * @brief Whether the call stack of `location` is within an excluded
+        * region, or outside of all included regions.
+        */
+    bool is_region_filtered(const otf2::definition::location& location);
+
+    /**
+        * @brief Whether the path of `file` is filtered, the path filter is
+        * applied once per file reference and cached.
+        */
+    bool is_file_filtered(const otf2::definition::io_file& file);
+
+    template<typename Definition>
+    static bool is_set(const std::vector<bool>& table, const otf2::reference<Definition>& ref)
+    {
+        const typename otf2::reference<Definition>::ref_type idx = ref;
+        return idx < table.size() && table[idx];
+    }
+
 public:
     // Event callbacks
 
@@ -214,7 +520,19 @@ public:
     void definitions_done(const otf2::reader::reader& rdr) override;
 
 private:
-    location_queue<otf2::event::io_operation_begin> io_ops_started_;
+    builder_config config_;
+    location_hash_map<io_operation_key, pending_io_operation, io_operation_key_hash> io_ops_started_;
+    // non-blocking point-to-point requests by request id
+    location_hash_map<std::uint64_t, pending_request> requests_ {};
+    // latest vertex per I/O handle, used to link the layers
+    location_hash_map<std::uint64_t, VertexDescriptor> handle_vertices_ {};
+    // matching id of the latest operation begun per I/O handle, used to find
+    // the operation of a parent handle a nested operation is part of
+    location_hash_map<std::uint64_t, std::uint64_t> handle_operations_ {};
+    // collective I/O operations, matched to calls when all events are read
+    location_queue<collective_io_candidate> collective_ios_;
+    // selected members per communicator of a collective I/O call
+    std::unordered_map<std::uint64_t, std::vector<std::uint64_t>> collective_io_members_ {};
     mapping_type mapping_;
     location_queue<VertexDescriptor> edge_points_;
     location_stack<std::string> region_name_queue_;
@@ -226,11 +544,30 @@ private:
     otf2::chrono::duration total_time_ = otf2::chrono::duration(0);
     otf2::chrono::duration total_file_io_time_ = otf2::chrono::duration(0);
     otf2::chrono::duration total_file_io_metadata_time_ = otf2::chrono::duration(0);
-    otf2::chrono::time_point min_tp_ = otf2::chrono::genesis();
-    otf2::chrono::time_point max_tp_ = otf2::chrono::armageddon();
+    // first and last event time within the window, empty until the first event
+    otf2::chrono::time_point min_tp_ = otf2::chrono::armageddon();
+    otf2::chrono::time_point max_tp_ = otf2::chrono::genesis();
     otf2::definition::clock_properties clock_props_;
     std::map<std::string, std::string> file_to_fs_map_ {};
-    location_map<std::string, offset_tracker> offset_map_ {};
+    // file position per I/O handle, duplicated handles share their position
+    location_hash_map<std::uint64_t, std::shared_ptr<offset_tracker>> file_positions_ {};
+    // status flags per I/O handle, changed by io_change_status_flag
+    location_hash_map<std::uint64_t, otf2::common::io_status_flag_type> handle_status_ {};
+    // lock owner tables per handle and lock type
+    location_hash_map<lock_key, held_lock, lock_key_hash> held_locks_ {};
+    location_hash_map<lock_key, lock_attempts, lock_key_hash> lock_tries_ {};
+    std::vector<io_lock_interval> lock_intervals_ {};
+    // filter lookup tables, indexed by definition reference
+    std::vector<bool> filtered_handles_ {};
+    std::vector<bool> filtered_paradigms_ {};
+    std::vector<bool> included_regions_ {};
+    std::vector<bool> excluded_regions_ {};
+    std::vector<bool> resolved_files_ {};
+    std::vector<bool> filtered_files_ {};
+    bool has_region_filter_ = false;
+    bool has_included_regions_ = false;
+    location_stack<region_scope> region_scopes_ {};
+    ingestion_stats ingestion_ {};
 };
 
 struct OTF2_Io_Graph_Builder
@@ -238,33 +575,64 @@ struct OTF2_Io_Graph_Builder
     using graph_type = rabbitxx::IoGraph;
 
     //TODO: should be better use decltype(auto) or just return graph_type.
-    auto operator()(const std::string& trace_file, boost::mpi::communicator& comm) const
+    auto operator()(const std::string& trace_file, boost::mpi::communicator& comm,
+                    const builder_config& config) const
     {
         otf2::reader::reader trc_reader(trace_file);
         auto num_locations = trc_reader.num_locations();
-        io_graph_builder builder(comm, num_locations);
+        io_graph_builder builder(comm, num_locations, config);
+        if (config.presize != presize_mode::none && comm.rank() == 0)
+        {
+            builder.reserve(estimate_graph_size(trace_file, config));
+        }
         trc_reader.set_callback(builder);
-        trc_reader.read_definitions();
-        comm.barrier();
-        trc_reader.read_events();
-        comm.barrier();
+        {
+            profile_scope scope("read definitions");
+            trc_reader.read_definitions();
+            comm.barrier();
+        }
+        {
+            profile_scope scope("read events");
+            trc_reader.read_events();
+            comm.barrier();
+        }
 
         return builder.graph();
     }
 
+    auto operator()(const std::string& trace_file, boost::mpi::communicator& comm) const
+    {
+        return this->operator()(trace_file, comm, builder_config());
+    }
+
     // non-mpi version, overload without communicatior
-    auto operator()(const std::string& trace_file) const
+    auto operator()(const std::string& trace_file, const builder_config& config) const
     {
         otf2::reader::reader trc_reader(trace_file);
         auto num_locations = trc_reader.num_locations();
-        io_graph_builder builder(num_locations);
+        io_graph_builder builder(num_locations, config);
+        if (config.presize != presize_mode::none)
+        {
+            builder.reserve(estimate_graph_size(trace_file, config));
+        }
         trc_reader.set_callback(builder);
-        trc_reader.read_definitions();
-        trc_reader.read_events();
+        {
+            profile_scope scope("read definitions");
+            trc_reader.read_definitions();
+        }
+        {
+            profile_scope scope("read events");
+            trc_reader.read_events();
+        }
 
         return builder.graph();
     }
 
+    auto operator()(const std::string& trace_file) const
+    {
+        return this->operator()(trace_file, builder_config());
+    }
+
 };
 
 }} // namespace rabbitxx::graph
@@ -0,0 +1,344 @@
+#ifndef RABBITXX_GRAPH_SYNC_MATCHING_HPP
+#define RABBITXX_GRAPH_SYNC_MATCHING_HPP
+
+#include <rabbitxx/graph/io_graph.hpp>
+#include <rabbitxx/log.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rabbitxx { namespace graph {
+
+/**
+ * @brief I/O vertex of a process taking part in a collective I/O call, e.g.
+ * MPI_File_write_all, before the call is matched.
+ */
+struct collective_io_candidate
+{
+    VertexDescriptor vertex;
+    // reference of the communicator of the I/O handle
+    std::uint64_t comm;
+};
+
+namespace detail {
+
+    // (process id, remote process id, message tag) of a point-to-point event
+    struct p2p_channel
+    {
+        std::uint64_t proc;
+        std::uint64_t remote;
+        std::uint32_t tag;
+
+        bool operator==(const p2p_channel& other) const noexcept
+        {
+            return proc == other.proc && remote == other.remote && tag == other.tag;
+        }
+    };
+
+    struct p2p_channel_hash
+    {
+        std::size_t operator()(const p2p_channel& c) const noexcept
+        {
+            return std::hash<std::uint64_t>()(c.proc) ^ (std::hash<std::uint64_t>()(c.remote) << 1)
+                ^ (std::hash<std::uint32_t>()(c.tag) << 2);
+        }
+    };
+
+    /**
+     * @brief Unmatched synchronization events, in the order they occurred.
+     *
+     * Collectives are queued per process and point-to-point events per
+     * (process, remote process, tag), so the counterpart of an event is
+     * always at the front of its queue, even if messages with different tags
+     * overtake each other.
+     */
+    struct sync_candidates
+    {
+        std::unordered_map<std::uint64_t, std::deque<VertexDescriptor>> collectives;
+        std::unordered_map<p2p_channel, std::deque<VertexDescriptor>, p2p_channel_hash> p2p;
+    };
+
+    // (process id, communicator, file) of a collective I/O operation
+    struct collective_io_slot
+    {
+        std::uint64_t proc;
+        std::uint64_t comm;
+        std::string file;
+
+        bool operator==(const collective_io_slot& other) const noexcept
+        {
+            return proc == other.proc && comm == other.comm && file == other.file;
+        }
+    };
+
+    struct collective_io_slot_hash
+    {
+        std::size_t operator()(const collective_io_slot& slot) const noexcept
+        {
+            return std::hash<std::string>()(slot.file) ^ (std::hash<std::uint64_t>()(slot.proc) << 1)
+                ^ (std::hash<std::uint64_t>()(slot.comm) << 2);
+        }
+    };
+
+    using collective_io_candidates = std::unordered_map<collective_io_slot,
+                                                        std::deque<VertexDescriptor>,
+                                                        collective_io_slot_hash>;
+
+    /**
+     * @brief Take the first unmatched event of `key` from `queues`.
+     *
+     * @return false if there is none.
+     */
+    template<typename Queues, typename Key>
+    bool take_front(Queues& queues, const Key& key, std::vector<bool>& matched, VertexDescriptor& vd)
+    {
+        auto it = queues.find(key);
+        if (it == queues.end() || it->second.empty()) {
+            return false;
+        }
+        vd = it->second.front();
+        it->second.pop_front();
+        matched[vd] = true;
+        return true;
+    }
+
+} // namespace detail
+
+/**
+ * @brief Connect the synchronization events of all processes.
+ *
+ * For each group of corresponding synchronization events, the first one
+ * found becomes the root event. Edges are drawn from the root event to all
+ * other events of the group and their `root_event` is set to the root.
+ * Matched events are removed from the queues.
+ *
+ * The counterparts are looked up in per-process and per-channel queues, so the
+ * matching takes linear time in the number of synchronization events.
+ *
+ * @param graph: The graph holding the synchronization vertices.
+ * @param synchronizations: Queue of synchronization vertices per process id,
+ * in the order they occurred. Needs `begin()`, `end()` iterating over
+ * (process id, std::deque<VertexDescriptor>) pairs.
+ * @param partial: If true, events without counterpart are accepted, since
+ * just a part of the trace has been read.
+ *
+ * @return false if a synchronization event has no counterpart.
+ */
+template<typename SyncQueues>
+bool match_synchronizations(IoGraph& graph, SyncQueues& synchronizations, bool partial)
+{
+    // get property map of all properties
+    auto p_map = get(&otf2_trace_event::property, *graph.get());
+
+    detail::sync_candidates candidates;
+    for (const auto& loc_events : synchronizations)
+    {
+        for (const auto& v : loc_events.second)
+        {
+            const auto& vertex = boost::get<sync_event_property>(get(p_map, v));
+            if (vertex.comm_kind == sync_event_kind::collective) {
+                candidates.collectives[loc_events.first].push_back(v);
+            }
+            else {
+                const auto& p2p_op = boost::get<peer2peer>(vertex.op_data);
+                candidates.p2p[{ loc_events.first, p2p_op.remote_process(), p2p_op.msg_tag() }]
+                    .push_back(v);
+            }
+        }
+    }
+    // events which have been matched as counterpart of another event
+    std::vector<bool> matched(graph.num_vertices(), false);
+
+    for (const auto& loc_events : synchronizations)
+    {
+        // iterate through all vertex desciptors of sync_events occuring on this location
+        for (const auto& v : loc_events.second)
+        {
+            if (matched[v]) {
+                continue;
+            }
+            auto& vertex = boost::get<sync_event_property>(get(p_map, v)); // get the corresponding sync event property
+            // Distinguish between sync_event_kind's atm. just collective and p2p.
+            if (vertex.comm_kind == sync_event_kind::collective)
+            {
+                auto coll_op = boost::get<collective>(vertex.op_data);
+                if (coll_op.root() <= coll_op.members().size()) { // or just if (coll_op.has_root())
+                    // root rank is in the range of members
+                    if (vertex.proc_id != coll_op.root()) {
+                        continue; //draw edges only from root!
+                    }
+                }
+                for (const auto m : coll_op.members())
+                {
+                    if (vertex.proc_id == m) {
+                        continue; // skip myself, do not draw cycles
+                    }
+                    //find corresponding collective for every participating location.
+                    VertexDescriptor trg;
+                    if (!detail::take_front(candidates.collectives, m, matched, trg)) {
+                        if (partial) {
+                            // the counterpart is outside of the window
+                            continue;
+                        }
+                        logging::fatal() << "cannot find corresponding collective event for member: "
+                            << m << "\n" << vertex;
+                        return false;
+                    }
+                    //TODO: ist gefundene collective auch member der aktuellen
+                    auto& trg_vertex = boost::get<sync_event_property>(get(p_map, trg));
+                    // set root event
+                    trg_vertex.root_event = v;
+                    graph.add_edge(v, trg);
+                }
+            }
+            else // peer2peer synchronization event
+            {
+                assert(vertex.comm_kind == sync_event_kind::p2p);
+                auto p2p_op = boost::get<peer2peer>(vertex.op_data);
+                const auto remote = p2p_op.remote_process();
+                // first event of the remote process communicating with me by this tag
+                const detail::p2p_channel channel { remote, vertex.proc_id, p2p_op.msg_tag() };
+                VertexDescriptor trg;
+                if (!detail::take_front(candidates.p2p, channel, matched, trg)) {
+                    if (partial) {
+                        // the counterpart is outside of the window
+                        vertex.root_event = v;
+                        continue;
+                    }
+                    logging::fatal() << "cannot find corresponding p2p event";
+                    return false;
+                }
+                auto& trg_vertex = boost::get<sync_event_property>(get(p_map, trg));
+                //set root event
+                trg_vertex.root_event = v;
+                graph.add_edge(v, trg);
+            }
+            // set sync event as root
+            vertex.root_event = v;
+        }
+    }
+
+    for (auto& loc_events : synchronizations)
+    {
+        auto& events = loc_events.second;
+        events.erase(std::remove_if(events.begin(), events.end(),
+                        [&matched](const VertexDescriptor& vd) { return matched[vd]; }),
+                     events.end());
+    }
+    return true;
+}
+
+/**
+ * @brief Add one vertex per collective I/O call, e.g. MPI_File_write_all.
+ *
+ * Like collective synchronizations, the n-th collective operation of a
+ * process on a communicator and file belongs to the same call as the n-th
+ * one of every other member. The first operation found creates the call
+ * vertex, which gets an edge to the I/O vertex of each member. The I/O
+ * vertices keep their place in the chain of their process and refer to the
+ * call by `collective_event`. So the graph grows by one vertex per call
+ * instead of one per call and process.
+ *
+ * @param graph: The graph holding the I/O vertices.
+ * @param collective_ios: Queue of collective I/O operations per process id,
+ * in the order they occurred. Needs `begin()`, `end()` iterating over
+ * (process id, std::deque<collective_io_candidate>) pairs.
+ * @param members: Process ids of the members per communicator reference.
+ * @param partial: If true, operations without counterpart are accepted,
+ * since just a part of the trace has been read.
+ *
+ * @return false if a collective I/O operation has no counterpart.
+ */
+template<typename CollectiveQueues, typename Members>
+bool match_collective_io(IoGraph& graph, CollectiveQueues& collective_ios, const Members& members,
+                        bool partial)
+{
+    auto p_map = get(&otf2_trace_event::property, *graph.get());
+
+    detail::collective_io_candidates candidates;
+    for (const auto& loc_ops : collective_ios)
+    {
+        for (const auto& op : loc_ops.second)
+        {
+            const auto& vertex = boost::get<io_event_property>(get(p_map, op.vertex));
+            candidates[detail::collective_io_slot { loc_ops.first, op.comm, vertex.filename }]
+                .push_back(op.vertex);
+        }
+    }
+    std::vector<bool> matched(graph.num_vertices(), false);
+
+    for (const auto& loc_ops : collective_ios)
+    {
+        for (const auto& op : loc_ops.second)
+        {
+            if (matched[op.vertex]) {
+                continue;
+            }
+            // copy, adding the call vertex invalidates references to the properties
+            const auto vertex = boost::get<io_event_property>(get(p_map, op.vertex));
+            std::vector<VertexDescriptor> ops;
+            for (const auto m : members.at(op.comm))
+            {
+                // the operation itself is the first unmatched one of its process
+                VertexDescriptor trg;
+                if (!detail::take_front(candidates,
+                                        detail::collective_io_slot { m, op.comm, vertex.filename },
+                                        matched, trg)) {
+                    if (partial) {
+                        // the counterpart is outside of the window
+                        continue;
+                    }
+                    logging::fatal() << "cannot find corresponding collective I/O operation for member: "
+                        << m << "\n" << vertex;
+                    return false;
+                }
+                ops.push_back(trg);
+            }
+            if (ops.empty()) {
+                continue;
+            }
+
+            auto call = collective_io_property(vertex.filename, vertex.region_name, vertex.paradigm);
+            for (const auto trg : ops)
+            {
+                const auto& member = boost::get<io_event_property>(get(p_map, trg));
+                if (member.kind == io_event_kind::read || member.kind == io_event_kind::write)
+                {
+                    // the offset is the file position after the operation
+                    call.ranges.add(member.proc_id, member.offset - member.response_size,
+                                    member.response_size);
+                    call.bytes += member.response_size;
+                }
+                const auto begin = member.iop_duration ? member.timestamp - *member.iop_duration
+                                                       : member.timestamp;
+                call.begin = std::min(call.begin, begin);
+                call.end = std::max(call.end, member.timestamp);
+            }
+            const auto call_vd = graph.add_vertex(otf2_trace_event(call));
+            graph[call_vd].duration = { call.end - call.begin, call.begin, call.end };
+            for (const auto trg : ops)
+            {
+                boost::get<io_event_property>(graph[trg].property).collective_event = call_vd;
+                graph.add_edge(call_vd, trg);
+            }
+        }
+    }
+
+    for (auto& loc_ops : collective_ios)
+    {
+        auto& ops = loc_ops.second;
+        ops.erase(std::remove_if(ops.begin(), ops.end(),
+                    [&matched](const collective_io_candidate& op) { return matched[op.vertex]; }),
+                  ops.end());
+    }
+    return true;
+}
+
+}} // namespace rabbitxx::graph
+
+#endif // RABBITXX_GRAPH_SYNC_MATCHING_HPP
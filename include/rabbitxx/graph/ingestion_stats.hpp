@@ -0,0 +1,254 @@
+#ifndef RABBITXX_GRAPH_INGESTION_STATS_HPP
+#define RABBITXX_GRAPH_INGESTION_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace rabbitxx { namespace graph {
+
+/**
+ * @brief Event callbacks of the `io_graph_builder`.
+ */
+enum class callback_type : std::size_t
+{
+    enter,
+    leave,
+    io_operation_begin,
+    io_operation_complete,
+    io_operation_issued,
+    io_operation_test,
+    io_operation_cancelled,
+    io_acquire_lock,
+    io_try_lock,
+    io_release_lock,
+    io_change_status_flag,
+    io_create_handle,
+    io_delete_file,
+    io_destroy_handle,
+    io_duplicate_handle,
+    io_seek,
+    mpi_collective_begin,
+    mpi_collective_end,
+    mpi_send,
+    mpi_isend,
+    mpi_isend_complete,
+    mpi_receive,
+    mpi_ireceive,
+    mpi_ireceive_request,
+    mpi_request_test,
+    mpi_request_cancelled,
+    unknown,
+    count // number of callback types, keep last
+};
+
+constexpr std::size_t num_callback_types = static_cast<std::size_t>(callback_type::count);
+
+const char* to_string(callback_type type);
+
+/**
+ * @brief Counters of one callback type.
+ *
+ * seen:      events delivered to the callback
+ * filtered:  events dropped by the rank, window, location or I/O filter
+ * converted: events which created or extended a vertex
+ * bytes:     bytes transferred by I/O operations and messages
+ * time:      time spent in the callback
+ */
+struct callback_counts
+{
+    std::uint64_t seen = 0;
+    std::uint64_t filtered = 0;
+    std::uint64_t converted = 0;
+    std::uint64_t bytes = 0;
+    std::chrono::nanoseconds time {0};
+
+    callback_counts& operator+=(const callback_counts& other);
+};
+
+/**
+ * @brief Final ingestion counters of a graph, stored in `app_info`.
+ */
+struct ingestion_summary
+{
+    std::array<callback_counts, num_callback_types> per_type {};
+    // number of events of the read locations according to the definitions
+    std::uint64_t expected_events = 0;
+    // wall time from the first to the last event
+    std::chrono::nanoseconds elapsed {0};
+
+    const callback_counts& operator[](callback_type type) const
+    {
+        return per_type[static_cast<std::size_t>(type)];
+    }
+
+    callback_counts total() const;
+
+    double events_per_second() const;
+};
+
+std::ostream& operator<<(std::ostream& os, const ingestion_summary& summary);
+
+/**
+ * @brief Lock-free per-callback counters with periodic progress reports.
+ *
+ * All counters are relaxed atomics, so they can be read while the trace is
+ * being read, e.g. by a progress monitor.
+ */
+class ingestion_stats
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    ingestion_stats() = default;
+    ingestion_stats(const ingestion_stats&) = delete;
+    ingestion_stats& operator=(const ingestion_stats&) = delete;
+
+    /**
+     * @brief Set the total number of events used for the estimated time
+     * remaining.
+     */
+    void set_expected_events(std::uint64_t num_events) noexcept
+    {
+        expected_events_ = num_events;
+    }
+
+    /**
+     * @brief Report progress every `interval`, a zero interval disables the
+     * reports.
+     */
+    void set_progress_interval(std::chrono::duration<double> interval) noexcept
+    {
+        progress_interval_ = interval;
+    }
+
+    void count_seen(callback_type type)
+    {
+        at(type).seen.fetch_add(1, std::memory_order_relaxed);
+        const auto seen = seen_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (seen == 1) {
+            start_ = clock::now();
+            last_report_ = start_;
+        }
+        // check the clock just every few thousand events
+        if (progress_interval_.count() > 0 && seen % progress_check_interval == 0) {
+            report_progress(seen);
+        }
+    }
+
+    void count_filtered(callback_type type) noexcept
+    {
+        at(type).filtered.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void count_converted(callback_type type) noexcept
+    {
+        at(type).converted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void count_bytes(callback_type type, std::uint64_t bytes) noexcept
+    {
+        at(type).bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void count_time(callback_type type, clock::duration time) noexcept
+    {
+        at(type).time_ns.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+                std::memory_order_relaxed);
+    }
+
+    std::uint64_t events_seen() const noexcept
+    {
+        return seen_.load(std::memory_order_relaxed);
+    }
+
+    ingestion_summary summary() const;
+
+private:
+    struct counter
+    {
+        std::atomic<std::uint64_t> seen {0};
+        std::atomic<std::uint64_t> filtered {0};
+        std::atomic<std::uint64_t> converted {0};
+        std::atomic<std::uint64_t> bytes {0};
+        std::atomic<std::uint64_t> time_ns {0};
+    };
+
+    static constexpr std::uint64_t progress_check_interval = 4096;
+
+    counter& at(callback_type type) noexcept
+    {
+        return counters_[static_cast<std::size_t>(type)];
+    }
+
+    void report_progress(std::uint64_t seen);
+
+    std::array<counter, num_callback_types> counters_ {};
+    std::atomic<std::uint64_t> seen_ {0};
+    std::uint64_t expected_events_ = 0;
+    std::chrono::duration<double> progress_interval_ {0};
+    clock::time_point start_ {};
+    clock::time_point last_report_ {};
+};
+
+/**
+ * @brief Account one callback invocation.
+ *
+ * Counts the event as seen on construction and the time spent in the
+ * callback on destruction. The event is counted as converted if the number
+ * of vertices grew while the guard was alive, or if `converted` is called.
+ */
+template<typename Graph>
+class ingestion_guard
+{
+public:
+    ingestion_guard(ingestion_stats& stats, callback_type type, const Graph& graph)
+        : stats_(stats), type_(type), graph_(graph),
+        num_vertices_(graph.num_vertices()), start_(ingestion_stats::clock::now())
+    {
+        stats_.count_seen(type_);
+    }
+
+    ~ingestion_guard()
+    {
+        if (!filtered_ && (converted_ || graph_.num_vertices() > num_vertices_)) {
+            stats_.count_converted(type_);
+        }
+        stats_.count_time(type_, ingestion_stats::clock::now() - start_);
+    }
+
+    ingestion_guard(const ingestion_guard&) = delete;
+    ingestion_guard& operator=(const ingestion_guard&) = delete;
+
+    void filtered() noexcept
+    {
+        filtered_ = true;
+        stats_.count_filtered(type_);
+    }
+
+    void converted() noexcept
+    {
+        converted_ = true;
+    }
+
+    void bytes(std::uint64_t num_bytes) noexcept
+    {
+        stats_.count_bytes(type_, num_bytes);
+    }
+
+private:
+    ingestion_stats& stats_;
+    callback_type type_;
+    const Graph& graph_;
+    std::uint64_t num_vertices_;
+    ingestion_stats::clock::time_point start_;
+    bool filtered_ = false;
+    bool converted_ = false;
+};
+
+}} // namespace rabbitxx::graph
+
+#endif // RABBITXX_GRAPH_INGESTION_STATS_HPP
@@ -8,10 +8,15 @@
 
 #include <otf2xx/otf2.hpp>
 
+#include <rabbitxx/graph/ingestion_stats.hpp>
 #include <rabbitxx/log.hpp>
 #include <rabbitxx/utils.hpp>
 
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <limits>
+#include <vector>
 
 namespace rabbitxx {
 
@@ -26,6 +31,7 @@ enum class vertex_kind
     io_event,
     sync_event,
     synthetic,
+    collective_io,
     none,
 };
 
@@ -39,6 +45,8 @@ inline std::ostream& operator<<(std::ostream& os, const vertex_kind& kind)
             os << "sync event"; break;
         case vertex_kind::synthetic:
             os << "synthetic"; break;
+        case vertex_kind::collective_io:
+            os << "collective io"; break;
         case vertex_kind::none:
             os << "None"; break;
     }
@@ -199,6 +207,177 @@ inline std::ostream& operator<<(std::ostream& os, const io_event_kind& io_kind)
     return os;
 }
 
+/**
+ * Summary of a run of back-to-back read or write operations on the same file
+ * which were folded into a single vertex.
+ * The covered byte range is [first_offset, last_offset).
+ */
+struct io_range
+{
+    // number of buckets of the duration histogram
+    static constexpr std::size_t histogram_size = 16;
+
+    std::uint64_t count {0}; // number of folded operations
+    std::uint64_t first_offset {0};
+    std::uint64_t last_offset {0};
+    std::uint64_t total_bytes {0};
+    otf2::chrono::time_point first_timestamp = otf2::chrono::armageddon(); // begin of the first operation
+    otf2::chrono::time_point last_timestamp = otf2::chrono::genesis(); // completion of the last operation
+    // log2-histogram of operation durations in microseconds,
+    // bucket 0 holds durations below 1us, bucket i holds [2^(i-1), 2^i) us.
+    std::array<std::uint64_t, histogram_size> duration_histogram {};
+
+    io_range() = default;
+
+    explicit io_range(std::uint64_t offset_begin, std::uint64_t bytes,
+                    const otf2::chrono::duration& dur, const otf2::chrono::time_point& ts) noexcept
+        : first_offset(offset_begin), last_offset(offset_begin)
+    {
+        add(bytes, dur, ts);
+    }
+
+    /**
+     * @brief Append an operation which starts at `last_offset`.
+     */
+    void add(std::uint64_t bytes, const otf2::chrono::duration& dur,
+            const otf2::chrono::time_point& ts) noexcept
+    {
+        ++count;
+        last_offset += bytes;
+        total_bytes += bytes;
+        first_timestamp = std::min(first_timestamp, ts - dur);
+        last_timestamp = std::max(last_timestamp, ts);
+        ++duration_histogram[histogram_bucket(dur)];
+    }
+
+    static std::size_t histogram_bucket(const otf2::chrono::duration& dur) noexcept
+    {
+        auto us = std::chrono::duration_cast<otf2::chrono::microseconds>(dur).count();
+        std::size_t bucket = 0;
+        while (us > 0 && bucket < histogram_size - 1)
+        {
+            us >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const io_range& range)
+{
+    os << "count: " << range.count
+        << " range: [" << range.first_offset << ", " << range.last_offset << ")"
+        << " total bytes: " << range.total_bytes
+        << " first: " << range.first_timestamp
+        << " last: " << range.last_timestamp
+        << " duration histogram: ";
+    std::copy(range.duration_histogram.begin(), range.duration_histogram.end(),
+            std::ostream_iterator<std::uint64_t>(os, " "));
+    return os;
+}
+
+/**
+ * @brief Timestamps of a non-blocking I/O operation, e.g. aio or MPI_File_iread.
+ *
+ * The operation is started at `begin`, the call returns at `issued` and the
+ * operation proceeds in the background until its completion is detected at
+ * `complete`. The process can compute in [issued, complete].
+ */
+struct io_async_info
+{
+    otf2::chrono::time_point begin = otf2::chrono::genesis();
+    otf2::chrono::time_point issued = otf2::chrono::genesis();
+    otf2::chrono::time_point complete = otf2::chrono::genesis();
+    // number of completion tests which found the operation still in flight
+    std::uint64_t num_tests {0};
+
+    io_async_info() = default;
+
+    explicit io_async_info(const otf2::chrono::time_point& begin_ts,
+                            const otf2::chrono::time_point& issued_ts,
+                            const otf2::chrono::time_point& complete_ts,
+                            std::uint64_t tests) noexcept
+        : begin(begin_ts), issued(issued_ts), complete(complete_ts), num_tests(tests)
+    {
+    }
+
+    /**
+     * @brief Time the operation was in flight after the call returned, i.e.
+     * the time available for overlapping computation.
+     */
+    otf2::chrono::duration in_flight() const noexcept
+    {
+        return complete - issued;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const io_async_info& async)
+{
+    return os << "begin: " << async.begin
+        << " issued: " << async.issued
+        << " complete: " << async.complete
+        << " tests: " << async.num_tests;
+}
+
+/**
+ * @brief Byte ranges of the processes taking part in one collective I/O call,
+ * e.g. MPI_File_write_all.
+ *
+ * Consecutive processes accessing consecutive blocks of the same size, the
+ * common pattern of collective buffering, are stored as a single run. So the
+ * size is proportional to the number of irregular accesses instead of the
+ * number of processes.
+ */
+struct collective_io_info
+{
+    struct block_run
+    {
+        std::uint64_t first_proc;
+        std::uint64_t num_procs;
+        // offset of the block of `first_proc`, process `first_proc + i`
+        // accesses [offset + i * size, offset + (i + 1) * size)
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    std::vector<block_run> runs;
+
+    void add(std::uint64_t proc_id, std::uint64_t offset, std::uint64_t size)
+    {
+        if (!runs.empty())
+        {
+            auto& last = runs.back();
+            if (last.first_proc + last.num_procs == proc_id && last.size == size
+                    && last.offset + last.num_procs * size == offset) {
+                ++last.num_procs;
+                return;
+            }
+        }
+        runs.push_back(block_run { proc_id, 1, offset, size });
+    }
+
+    std::uint64_t num_procs() const noexcept
+    {
+        std::uint64_t num = 0;
+        for (const auto& run : runs)
+        {
+            num += run.num_procs;
+        }
+        return num;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const collective_io_info& coll)
+{
+    os << "processes: " << coll.num_procs() << " runs: [";
+    for (const auto& run : coll.runs)
+    {
+        os << " {" << run.first_proc << "+" << run.num_procs << " @" << run.offset
+            << " x " << run.size << "}";
+    }
+    return os << " ]";
+}
+
 struct io_event_property
 {
     using option_type = boost::variant<io_operation_option_container,
@@ -220,9 +399,30 @@ struct io_event_property
     io_event_kind kind;
     boost::optional<otf2::chrono::duration> iop_duration;
     otf2::chrono::time_point timestamp;
+    // only set on read and write vertices if the graph was built with I/O compaction
+    boost::optional<io_range> range;
+    // only set on non-blocking operations
+    boost::optional<io_async_info> async;
+    // Latest vertex of the parent handle on the same process, e.g. the
+    // MPI-IO or HDF5 handle a POSIX operation belongs to. Only set if the
+    // graph was built with `keep_all_layers`.
+    std::size_t parent_event = std::numeric_limits<std::size_t>::max();
+    // Vertex of the collective I/O call this operation is part of. Only set
+    // if the graph was built with `aggregate_collective_io`.
+    std::size_t collective_event = std::numeric_limits<std::size_t>::max();
 
     io_event_property() = default;
 
+    bool has_parent_event() const noexcept
+    {
+        return parent_event != std::numeric_limits<std::size_t>::max();
+    }
+
+    bool is_collective() const noexcept
+    {
+        return collective_event != std::numeric_limits<std::size_t>::max();
+    }
+
     explicit io_event_property(
                         std::uint64_t process_id,           /* pid */
                         const std::string& fname,           /* filename */
@@ -252,7 +452,11 @@ inline std::ostream& operator<<(std::ostream& os, const io_event_property& verte
                 << "offset: " << vertex.offset << "\n"
                 << "mode: " << boost::apply_visitor(option_type_printer(), vertex.option) << "\n"
                 << "kind: " << vertex.kind << "\n"
-                << "timestamp: " << vertex.timestamp << "\n";
+                << "timestamp: " << vertex.timestamp << "\n"
+                << "range: " << vertex.range << "\n"
+                << "async: " << vertex.async << "\n"
+                << "parent event: " << (vertex.has_parent_event() ? std::to_string(vertex.parent_event) : "none") << "\n"
+                << "collective call: " << (vertex.is_collective() ? std::to_string(vertex.collective_event) : "none") << "\n";
 }
 
 enum class sync_event_kind
@@ -434,6 +638,47 @@ inline std::ostream& operator<<(std::ostream& os, const synthetic_event_property
     return os;
 }
 
+/**
+ * @brief One collective I/O call, e.g. MPI_File_write_all, of all
+ * participating processes.
+ *
+ * The call has an edge to the I/O vertex of each participating process,
+ * which stays in the chain of its process and refers to the call by
+ * `io_event_property::collective_event`. The call vertex belongs to no
+ * process, so it is not part of any CIO-Set.
+ */
+struct collective_io_property
+{
+    std::string filename;
+    std::string region_name;
+    std::string paradigm;
+    collective_io_info ranges;
+    // from the first begin to the last completion
+    otf2::chrono::time_point begin = otf2::chrono::armageddon();
+    otf2::chrono::time_point end = otf2::chrono::genesis();
+    std::uint64_t bytes = 0;
+
+    collective_io_property() = default;
+
+    explicit collective_io_property(const std::string& fname, const std::string& rname,
+                                    const std::string& paradigm) noexcept
+        : filename(fname), region_name(rname), paradigm(paradigm)
+    {
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const collective_io_property& vertex)
+{
+    return os << "[Collective-I/O]\n"
+                << "filename: " << vertex.filename << "\n"
+                << "region: " << vertex.region_name << "\n"
+                << "paradigm: " << vertex.paradigm << "\n"
+                << "ranges: " << vertex.ranges << "\n"
+                << "bytes: " << vertex.bytes << "\n"
+                << "begin: " << vertex.begin << "\n"
+                << "end: " << vertex.end << "\n";
+}
+
 struct timespan
 {
     otf2::chrono::duration duration = otf2::chrono::duration(0);
@@ -459,7 +704,8 @@ struct otf2_trace_event
 {
     using vertex_property = boost::variant<io_event_property,
                                             sync_event_property,
-                                            synthetic_event_property>;
+                                            synthetic_event_property,
+                                            collective_io_property>;
     vertex_kind type = vertex_kind::none;
     vertex_property property;
     //otf2::chrono::duration duration = otf2::chrono::duration(0);
@@ -486,6 +732,11 @@ struct otf2_trace_event
     {
     }
 
+    explicit otf2_trace_event(const collective_io_property& collective_p) noexcept
+        : type(vertex_kind::collective_io), property(collective_p)
+    {
+    }
+
     std::uint64_t id() const
     {
         if (type == vertex_kind::io_event) {
@@ -500,6 +751,10 @@ struct otf2_trace_event
             logging::debug() << "Synthetic Event has no process id return INT MAX.";
             return std::numeric_limits<std::uint64_t>::max();
         }
+        if (type == vertex_kind::collective_io) {
+            // a collective call belongs to all of its processes
+            return std::numeric_limits<std::uint64_t>::max();
+        }
 
         logging::fatal() << "This should not happen! property type seems wether of type io_event_property neither of type sync_event_property.";
         return std::numeric_limits<std::uint64_t>::max();
@@ -519,6 +774,10 @@ struct otf2_trace_event
             const auto& p = boost::get<synthetic_event_property>(property);
             return p.name;
         }
+        if (type == vertex_kind::collective_io) {
+            const auto& p = boost::get<collective_io_property>(property);
+            return p.region_name;
+        }
         logging::fatal() << "This should not happen! property type seems wether of type io_event_property neither of type sync_event_property.";
         return "";
     }
@@ -537,6 +796,10 @@ struct otf2_trace_event
             const auto& p = boost::get<synthetic_event_property>(property);
             return p.timestamp;
         }
+        if (type == vertex_kind::collective_io) {
+            const auto& p = boost::get<collective_io_property>(property);
+            return p.end;
+        }
         logging::fatal() << "ERROR invalid vertex_kind! Return MAX";
         return otf2::chrono::time_point::max();
     }
@@ -556,6 +819,9 @@ inline std::ostream& operator<<(std::ostream& os, const rabbitxx::otf2_trace_eve
         case vertex_kind::synthetic:
             os << vertex.property;
             break;
+        case vertex_kind::collective_io:
+            os << vertex.property;
+            break;
         case vertex_kind::none:
             os << "None";
             break;
@@ -564,6 +830,40 @@ inline std::ostream& operator<<(std::ostream& os, const rabbitxx::otf2_trace_eve
     return os;
 }
 
+/**
+ * A lock on an I/O handle, from its request until its release, e.g. a
+ * fcntl(2) or flock(2) lock.
+ *
+ * `requested` is the enter of the region of the acquisition or the first
+ * unsuccessful try, `acquired` the acquire event and `released` the release
+ * event. Nested acquisitions of the same lock are part of the outermost one.
+ */
+struct io_lock_interval
+{
+    std::uint64_t proc_id;
+    std::string filename;
+    // reference of the locked I/O handle
+    std::uint64_t handle;
+    otf2::common::lock_type type;
+    otf2::chrono::time_point requested;
+    otf2::chrono::time_point acquired;
+    otf2::chrono::time_point released;
+    // io_try_lock events which did not get the lock
+    std::uint64_t failed_tries = 0;
+    // status flags of the handle when the lock was acquired, e.g. non_blocking
+    otf2::common::io_status_flag_type status_flags = otf2::common::io_status_flag_type::none;
+
+    otf2::chrono::duration wait_time() const
+    {
+        return acquired - requested;
+    }
+
+    otf2::chrono::duration hold_time() const
+    {
+        return released - acquired;
+    }
+};
+
 /**
  * Graph property class, stores information about the overall program that are
  * gathered during construction.
@@ -578,6 +878,12 @@ struct app_info
     otf2::definition::clock_properties clock_props;
     std::map<std::string, std::string> file_to_fs;
     std::uint64_t num_locations;
+    // location reference of each process id
+    std::vector<std::uint64_t> locations;
+    // per callback event counters of the graph construction
+    graph::ingestion_summary ingestion;
+    // released locks of all processes, in order of their release
+    std::vector<io_lock_interval> lock_intervals;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const app_info& info)
@@ -643,6 +949,12 @@ class otf2_trace_event_writer
                 const auto property = boost::get<synthetic_event_property>(vertex.property);
                 os << R"([label=")" << property.name << R"(", color=gray])";
             }
+            else if (vertex.type == vertex_kind::collective_io) {
+                const auto property = boost::get<collective_io_property>(vertex.property);
+                os << R"([label=")" << "# " << vd << " " << property.region_name << R"(")"
+                    << ", color=blue"
+                    << "]";
+            }
             else {
                 logging::fatal() << "Unrecognized vertex property for graphviz output";
             }
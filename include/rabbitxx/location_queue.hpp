@@ -4,6 +4,7 @@
 #include <map>
 #include <deque>
 #include <stack>
+#include <unordered_map>
 
 namespace rabbitxx {
 
@@ -50,6 +51,76 @@ namespace rabbitxx {
         std::map<key_type, mapped_type> map_;
     };
 
+    /**
+     * Hash table per location, to pair events by an id in O(1).
+     */
+    template<typename key_t, typename value_t, typename hash_t = std::hash<key_t>>
+    class location_hash_map
+    {
+    public:
+        using mapped_type = std::unordered_map<key_t, value_t, hash_t>;
+        using key_type = otf2::reference<otf2::definition::location>::ref_type;
+
+        /**
+         * @brief Insert `value`, an existing value with the same key is replaced.
+         *
+         * @return true if the key was new.
+         */
+        bool insert(const otf2::definition::location& location, const key_t& key, const value_t& value)
+        {
+            auto res = map_[location.ref()].emplace(key, value);
+            if (!res.second) {
+                res.first->second = value;
+            }
+            return res.second;
+        }
+
+        /**
+         * @brief Find the value of `key`.
+         *
+         * @return Pointer to the value, or nullptr if there is none.
+         */
+        value_t* find(const otf2::definition::location& location, const key_t& key)
+        {
+            auto loc_it = map_.find(location.ref());
+            if (loc_it == map_.end()) {
+                return nullptr;
+            }
+            auto it = loc_it->second.find(key);
+            return it == loc_it->second.end() ? nullptr : &it->second;
+        }
+
+        bool erase(const otf2::definition::location& location, const key_t& key)
+        {
+            auto loc_it = map_.find(location.ref());
+            return loc_it != map_.end() && loc_it->second.erase(key) > 0;
+        }
+
+        // number of values of all locations
+        std::size_t size() const
+        {
+            std::size_t num = 0;
+            for (const auto& kvp : map_)
+            {
+                num += kvp.second.size();
+            }
+            return num;
+        }
+
+        auto begin()
+        {
+            return map_.begin();
+        }
+
+        auto end()
+        {
+            return map_.end();
+        }
+
+    private:
+        std::unordered_map<key_type, mapped_type> map_;
+    };
+
     template<typename QType>
     class location_queue
     {
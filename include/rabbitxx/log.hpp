@@ -14,6 +14,9 @@
 #include <nitro/log/filter/mpi_master_filter.hpp>
 #include <nitro/log/filter/severity_filter.hpp>
 
+#include <ostream>
+#include <type_traits>
+
 namespace rabbitxx
 {
     // Incomplete type_printer declaration.
@@ -56,7 +59,112 @@ namespace rabbitxx
         } // namespace detail
 
         typedef nitro::log::logger<detail::record, detail::rabbitxx_log_formater,
-                                   nitro::log::sink::StdErr, detail::rabbitxx_log_filter> logging;
+                                   nitro::log::sink::StdErr, detail::rabbitxx_log_filter> nitro_logging;
+
+        /**
+         * @brief Severity levels, ordered from the most to the least verbose.
+         */
+        enum class log_level : int
+        {
+            trace = 0,
+            debug = 1,
+            info = 2,
+            warn = 3,
+            error = 4,
+            fatal = 5
+        };
+
+        namespace detail
+        {
+            // Swallows everything, the stream of log levels which are compiled out.
+            struct null_stream
+            {
+                template<typename T>
+                null_stream& operator<<(const T&) noexcept
+                {
+                    return *this;
+                }
+
+                null_stream& operator<<(std::ostream& (*)(std::ostream&)) noexcept
+                {
+                    return *this;
+                }
+            };
+        } // namespace detail
+
+        /**
+         * @brief Logging facade with a compile-time minimum severity.
+         *
+         * Levels below `MinLevel` return a `null_stream`, so the message is
+         * never formatted and the statement compiles to nothing but the
+         * evaluation of its arguments. The other levels are passed to nitro,
+         * where the runtime severity filter applies as before.
+         */
+        template<log_level MinLevel>
+        class basic_logging : public nitro_logging
+        {
+            template<log_level Level>
+            using enabled = std::integral_constant<bool, (Level >= MinLevel)>;
+
+            template<typename MakeStream>
+            static auto select(std::true_type, MakeStream make_stream)
+            {
+                return make_stream();
+            }
+
+            template<typename MakeStream>
+            static detail::null_stream select(std::false_type, MakeStream)
+            {
+                return detail::null_stream();
+            }
+
+        public:
+            static constexpr log_level min_level = MinLevel;
+
+            static constexpr bool is_enabled(log_level level) noexcept
+            {
+                return level >= MinLevel;
+            }
+
+            static auto trace()
+            {
+                return select(enabled<log_level::trace>(), [] { return nitro_logging::trace(); });
+            }
+
+            static auto debug()
+            {
+                return select(enabled<log_level::debug>(), [] { return nitro_logging::debug(); });
+            }
+
+            static auto info()
+            {
+                return select(enabled<log_level::info>(), [] { return nitro_logging::info(); });
+            }
+
+            static auto warn()
+            {
+                return select(enabled<log_level::warn>(), [] { return nitro_logging::warn(); });
+            }
+
+            static auto error()
+            {
+                return select(enabled<log_level::error>(), [] { return nitro_logging::error(); });
+            }
+
+            // fatal messages are never compiled out
+            static auto fatal()
+            {
+                return nitro_logging::fatal();
+            }
+        };
+
+// Compile-time minimum severity, 0 (trace) to 5 (fatal), see `log_level`.
+// Set by the CMake cache variable RABBITXX_LOG_MIN_LEVEL.
+#ifndef RABBITXX_LOG_MIN_LEVEL
+#define RABBITXX_LOG_MIN_LEVEL 0
+#endif
+
+        using logging = basic_logging<static_cast<log_level>(RABBITXX_LOG_MIN_LEVEL)>;
 
         inline void set_min_severity_level(nitro::log::severity_level sev)
         {
@@ -5,8 +5,14 @@
 
 #include <otf2xx/definition/location.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <queue>
+#include <utility>
+#include <vector>
 
 namespace rabbitxx {
 
@@ -24,35 +30,163 @@ namespace rabbitxx {
      *
      * Mapping strategy:
      *
+     * A strategy is constructed with the number of ranks (or threads) and the
+     * number of locations. `prepare` is called once with all location
+     * definitions before the first location is registered, afterwards
+     * `operator()(location)` returns the rank responsible for the location.
+     *
+     * Block:
+     * consecutive locations, in the order of their references, are assigned
+     * to the same rank, the block sizes differ by at most one.
+     *
      * Round-Robin:
      * location % ranks = rank whose responsible for process the location
+     *
+     * Weighted-Greedy:
+     * locations are weighted by their number of events and assigned, heaviest
+     * first, to the rank with the least load so far (longest processing time
+     * first). This balances traces with a few very busy locations, e.g. I/O
+     * aggregators.
      */
 
     namespace detail
     {
+        struct block_mapping
+        {
+            explicit block_mapping(int nranks, int nlocations) noexcept
+                : ranks_(nranks), locations_(std::max(nlocations, 1))
+            {
+            }
+
+            template<typename Locations>
+            void prepare(const Locations& locations)
+            {
+                std::vector<std::uint64_t> refs;
+                for (const auto& location : locations)
+                {
+                    refs.push_back(location.ref());
+                }
+                assign(std::move(refs));
+            }
+
+            /**
+             * @brief Number the locations in the order of their references,
+             * so sparse references are split into blocks as well.
+             */
+            void assign(std::vector<std::uint64_t> refs)
+            {
+                std::sort(refs.begin(), refs.end());
+                locations_ = std::max<std::uint64_t>(refs.size(), 1);
+                index_.clear();
+                for (std::uint64_t i = 0; i < refs.size(); ++i)
+                {
+                    index_.emplace(refs[i], i);
+                }
+            }
+
+            int operator()(std::uint64_t location) const noexcept
+            {
+                // not prepared, take the reference as index
+                const auto it = index_.find(location);
+                const auto index = it == index_.end() ? location : it->second;
+                // locations beyond the announced number end up on the last rank
+                return static_cast<int>(std::min(index * ranks_ / locations_, ranks_ - 1));
+            }
+
+        private:
+            std::uint64_t ranks_;
+            std::uint64_t locations_;
+            std::map<std::uint64_t, std::uint64_t> index_;
+        };
+
         struct round_robin_mapping
         {
-            explicit round_robin_mapping(int nranks, int nlocations) noexcept
-                : ranks_(nranks), locations_(nlocations)
+            explicit round_robin_mapping(int nranks, int /* nlocations */) noexcept
+                : ranks_(nranks)
+            {
+            }
+
+            template<typename Locations>
+            void prepare(const Locations&) noexcept
+            {
+            }
+
+            int operator()(std::uint64_t location) const noexcept
+            {
+                return static_cast<int>(location % ranks_);
+            }
+
+        private:
+            std::uint64_t ranks_;
+        };
+
+        struct weighted_greedy_mapping
+        {
+            explicit weighted_greedy_mapping(int nranks, int /* nlocations */) noexcept
+                : ranks_(nranks)
             {
             }
 
             /**
-             * Return a mapping for each location to a rank map<location, rank>.
+             * @brief Weight the locations by the number of events from their
+             * definitions. Locations without recorded event count get a weight
+             * of one.
              */
-            std::map<int, int> operator()() const
+            template<typename Locations>
+            void prepare(const Locations& locations)
             {
-                std::map<int, int> round_robin_map;
-                for (int i = 0; i < locations_; ++i)
+                std::vector<std::pair<std::uint64_t, std::uint64_t>> weights;
+                for (const auto& location : locations)
                 {
-                    round_robin_map.emplace(i, i % ranks_);
+                    weights.emplace_back(location.ref(), std::max<std::uint64_t>(location.num_events(), 1));
                 }
-                return round_robin_map;
+                assign(weights);
+            }
+
+            /**
+             * @brief Assign each location to a rank.
+             *
+             * @param weights: Pairs of location reference and its weight.
+             */
+            void assign(std::vector<std::pair<std::uint64_t, std::uint64_t>> weights)
+            {
+                // heaviest first, ties by location for a deterministic result
+                std::sort(weights.begin(), weights.end(),
+                        [](const auto& lhs, const auto& rhs) {
+                            return lhs.second != rhs.second ? lhs.second > rhs.second
+                                                            : lhs.first < rhs.first;
+                        });
+                // min-heap of (load, rank)
+                using load_t = std::pair<std::uint64_t, int>;
+                std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t>> loads;
+                for (int rank = 0; rank < ranks_; ++rank)
+                {
+                    loads.emplace(0, rank);
+                }
+                assignment_.clear();
+                for (const auto& w : weights)
+                {
+                    auto least = loads.top();
+                    loads.pop();
+                    assignment_.emplace(w.first, least.second);
+                    least.first += w.second;
+                    loads.push(least);
+                }
+            }
+
+            int operator()(std::uint64_t location) const noexcept
+            {
+                const auto it = assignment_.find(location);
+                if (it == assignment_.end()) {
+                    // not prepared, fall back to round-robin
+                    return static_cast<int>(location % ranks_);
+                }
+                return it->second;
             }
 
         private:
             int ranks_;
-            int locations_;
+            std::map<std::uint64_t, int> assignment_;
         };
 
     } // namespace detail
@@ -77,14 +211,17 @@ namespace rabbitxx {
             {
                 assert(to_rank(location.ref()) == -1);
 
-                const auto map = strategy_();
-                const auto it = map.find(location.ref());
-                if (it == map.end()) {
-                    logging::fatal() << "Cannot register location #" << location.ref()
-                                     << " no mapping found!";
-                    return;
-                }
-                register_mapping(location, it->second);
+                register_mapping(location, strategy_(location.ref()));
+            }
+
+            /**
+             * @brief Pass all location definitions to the strategy, before
+             * the locations are registered.
+             */
+            template<typename Locations>
+            void prepare(const Locations& locations)
+            {
+                strategy_.prepare(locations);
             }
 
             int to_rank(const otf2::definition::location& location) const
@@ -0,0 +1,167 @@
+#ifndef RABBITXX_PROFILER_HPP
+#define RABBITXX_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rabbitxx
+{
+
+/**
+ * @brief Resource usage of the process at one point in time.
+ */
+struct resource_usage
+{
+    std::chrono::nanoseconds wall {0};
+    // user + system time of the process
+    std::chrono::nanoseconds cpu {0};
+    // high-water mark of the resident set size in bytes
+    std::uint64_t peak_rss = 0;
+    // only counted if built with RABBITXX_COUNT_ALLOCATIONS
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+
+    static resource_usage now();
+};
+
+/**
+ * @brief Accumulated measurements of one phase.
+ *
+ * The phases form a tree, `parent` is the index of the enclosing phase
+ * within the profile or `no_parent` for top-level phases.
+ */
+struct profile_entry
+{
+    static constexpr std::size_t no_parent = static_cast<std::size_t>(-1);
+
+    std::string name;
+    std::size_t parent = no_parent;
+    std::size_t depth = 0;
+    std::uint64_t calls = 0;
+    std::chrono::nanoseconds wall {0};
+    std::chrono::nanoseconds cpu {0};
+    // growth of the peak RSS while the phase was active, i.e. how much the
+    // phase raised the memory high-water mark
+    std::uint64_t peak_rss_delta = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+};
+
+/**
+ * @brief Tree of finished phases in order of their first occurrence.
+ */
+class profile
+{
+public:
+    const std::vector<profile_entry>& entries() const noexcept
+    {
+        return entries_;
+    }
+
+    bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    /**
+     * @brief Indices of the direct children of `parent`.
+     */
+    std::vector<std::size_t> children(std::size_t parent) const;
+
+    /**
+     * @brief Index of the child phase `name` of `parent`, it is created if
+     * it does not exist yet.
+     */
+    std::size_t find_or_add(std::size_t parent, const std::string& name);
+
+    profile_entry& operator[](std::size_t idx)
+    {
+        return entries_[idx];
+    }
+
+    const profile_entry& operator[](std::size_t idx) const
+    {
+        return entries_[idx];
+    }
+
+private:
+    std::vector<profile_entry> entries_;
+};
+
+std::ostream& operator<<(std::ostream& os, const profile& prof);
+
+/**
+ * @brief Hierarchical phase profiler.
+ *
+ * Phases are opened and closed with `profile_scope`, a phase opened while
+ * another one is active becomes its child. Repeated phases with the same
+ * name and parent are accumulated into one entry.
+ * The profiler is not thread-safe, phases must be opened on the main thread.
+ */
+class profiler
+{
+public:
+    static profiler& global();
+
+    void enter(const std::string& name);
+
+    void leave();
+
+    /**
+     * @brief All finished phases, open phases are not included.
+     */
+    const profile& result() const noexcept
+    {
+        return profile_;
+    }
+
+    void reset();
+
+    static constexpr bool counts_allocations()
+    {
+#ifdef RABBITXX_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    struct open_phase
+    {
+        std::size_t entry;
+        resource_usage start;
+    };
+
+    profile profile_;
+    std::vector<open_phase> stack_;
+};
+
+/**
+ * @brief RAII phase of the global profiler.
+ *
+ * Usage: { profile_scope scope("merge"); ... }
+ */
+class profile_scope
+{
+public:
+    explicit profile_scope(const std::string& name)
+    {
+        profiler::global().enter(name);
+    }
+
+    ~profile_scope()
+    {
+        profiler::global().leave();
+    }
+
+    profile_scope(const profile_scope&) = delete;
+    profile_scope& operator=(const profile_scope&) = delete;
+};
+
+} // namespace rabbitxx
+
+#endif // RABBITXX_PROFILER_HPP
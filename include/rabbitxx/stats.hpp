@@ -1,10 +1,12 @@
 #ifndef RABBITXX_STATS_HPP
 #define RABBITXX_STATS_HPP
 
+#include <rabbitxx/analysis/bandwidth.hpp>
 #include <rabbitxx/cio_set.hpp>
 #include <rabbitxx/graph.hpp>
 #include <rabbitxx/utils.hpp>
 #include <rabbitxx/log.hpp>
+#include <rabbitxx/profiler.hpp>
 
 using rabbitxx::logging;
 
@@ -20,8 +22,9 @@ public:
 
     File(std::string filename, const IoGraph& graph) : filename_(filename)
     {
-        auto fs_map = graph.graph_properties().file_to_fs;
-        file_system_ = fs_map[filename];
+        const auto& fs_map = graph.graph_properties().file_to_fs;
+        const auto fs = fs_map.find(filename);
+        file_system_ = fs != fs_map.end() ? fs->second : std::string();
     }
 
     const std::string filename() const
@@ -88,6 +91,8 @@ public:
     {
         std::transform(cio_sets.begin(), cio_sets.end(), std::back_inserter(set_durations_),
                 [&graph](const auto& set) { return get_set_duration(graph, set); });
+        std::transform(cio_sets.begin(), cio_sets.end(), std::back_inserter(set_bandwidths_),
+                [&graph](const auto& set) { return analysis::analyze_bandwidth(graph, set); });
     }
 
     std::uint64_t number_of_cio_sets() const
@@ -105,6 +110,15 @@ public:
         return set_durations_;
     }
 
+    /**
+     * @brief Effective bandwidth of each set, the bytes divided by the union
+     * of the busy intervals.
+     */
+    const std::vector<analysis::set_bandwidth>& get_set_bandwidths() const
+    {
+        return set_bandwidths_;
+    }
+
     otf2::chrono::duration build_time() const
     {
         return build_time_;
@@ -114,6 +128,7 @@ private:
     std::uint64_t num_cio_sets_;
     otf2::chrono::duration build_time_;
     std::vector<otf2::chrono::duration> set_durations_;
+    std::vector<analysis::set_bandwidth> set_bandwidths_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const CIO_Stats& stats)
@@ -124,6 +139,10 @@ inline std::ostream& operator<<(std::ostream& os, const CIO_Stats& stats)
     const auto set_durs = stats.get_set_durations();
     std::copy(set_durs.begin(), set_durs.end(), std::ostream_iterator<otf2::chrono::duration>(os, ", "));
     os << "\n";
+    for (const auto& bw : stats.get_set_bandwidths())
+    {
+        os << bw << "\n";
+    }
 
     return os;
 }
@@ -272,6 +291,33 @@ public:
         experiment_duration_ = experiment_dur;
     }
 
+    /**
+     * @brief Wall and cpu time, memory and allocations of the phases of the
+     * experiment.
+     */
+    const profile& phase_profile() const noexcept
+    {
+        return profile_;
+    }
+
+    void set_profile(const profile& prof)
+    {
+        profile_ = prof;
+    }
+
+    /**
+     * @brief Event counters per callback type of the graph construction.
+     */
+    const graph::ingestion_summary& ingestion() const noexcept
+    {
+        return ingestion_;
+    }
+
+    void set_ingestion(const graph::ingestion_summary& ingestion)
+    {
+        ingestion_ = ingestion;
+    }
+
 private:
     fs::path trace_file_;
     Graph_Stats graph_stats_;
@@ -281,6 +327,8 @@ private:
     otf2::definition::clock_properties clock_props_;
     std::chrono::duration<double> experiment_duration_ = std::chrono::duration<double>(0.0);
     std::uint64_t num_locations_ = 0;
+    profile profile_;
+    graph::ingestion_summary ingestion_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Experiment_Stats& stats)
@@ -290,6 +338,14 @@ inline std::ostream& operator<<(std::ostream& os, const Experiment_Stats& stats)
         << "Experiment Duration: " << stats.experiment_duration().count() << "\n"
         << "Number of locations: " << stats.num_locations() << "\n"
         << stats.graph_stats() << stats.pio_stats() <<  stats.cio_stats();
+    if (stats.ingestion().total().seen > 0)
+    {
+        os << "========== Ingestion ==========\n" << stats.ingestion();
+    }
+    if (!stats.phase_profile().empty())
+    {
+        os << "========== Profile ==========\n" << stats.phase_profile();
+    }
     //TODO: print clock properties and file system map
     return os;
 }
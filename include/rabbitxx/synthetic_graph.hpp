@@ -0,0 +1,56 @@
+#ifndef RABBITXX_SYNTHETIC_GRAPH_HPP
+#define RABBITXX_SYNTHETIC_GRAPH_HPP
+
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <ostream>
+
+namespace rabbitxx
+{
+
+/**
+ * @brief Generative model of a synthetic I/O graph.
+ *
+ * Every process executes `num_phases` phases. A phase consists of
+ * `io_per_phase` I/O events followed by the synchronization of the phase:
+ * optionally p2p exchanges between randomly paired processes and a
+ * collective, either over all processes or over the sub-communicators.
+ */
+struct synthetic_graph_config
+{
+    std::uint64_t num_procs = 4;
+    std::uint64_t num_phases = 4;
+    std::uint64_t io_per_phase = 8;
+    // Size of the sub-communicators, consecutive processes are grouped
+    // together. 0 means every collective spans all processes.
+    std::uint64_t comm_size = 0;
+    // Probability that a process exchanges a message with a random partner
+    // at the end of a phase.
+    double p2p_density = 0.0;
+    // Probability that a phase ends with a collective.
+    double collective_density = 1.0;
+    // true: all processes access one file, false: one file per process
+    bool shared_file = true;
+    std::uint64_t bytes_per_io = 4096;
+    std::uint64_t seed = 42;
+};
+
+std::ostream& operator<<(std::ostream& os, const synthetic_graph_config& cfg);
+
+/**
+ * @brief Build an `IoGraph` from a generative model, without any trace file.
+ *
+ * The graph has the same structure as the graphs of `io_graph_builder`:
+ * a synthetic root vertex with an edge to the first event of each process,
+ * one chain of events per process, the synchronizations connected by
+ * `match_synchronizations` and a synthetic end vertex after the last
+ * event of each process. Process ids are dense [0, num_procs).
+ *
+ * The same config and seed always result in the same graph.
+ */
+IoGraph make_synthetic_graph(const synthetic_graph_config& cfg);
+
+} // namespace rabbitxx
+
+#endif // RABBITXX_SYNTHETIC_GRAPH_HPP
@@ -0,0 +1,42 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/access_pattern.hpp>
+
+#include <array>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file>" << std::endl;
+        return 1;
+    }
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    std::array<std::uint64_t, 4> per_pattern {};
+    std::size_t set_idx = 0;
+    for (const auto& set : io_sets)
+    {
+        std::cout << "Set " << set_idx++ << "\n";
+        for (const auto& stream : analysis::classify_access_patterns(graph, set))
+        {
+            std::cout << stream << "\n";
+            ++per_pattern[static_cast<std::size_t>(stream.pattern)];
+        }
+    }
+
+    std::cout << "Streams per pattern:";
+    for (std::size_t i = 0; i < per_pattern.size(); ++i)
+    {
+        std::cout << " " << static_cast<analysis::access_pattern>(i) << ": " << per_pattern[i];
+    }
+    std::cout << std::endl;
+
+    return EXIT_SUCCESS;
+}
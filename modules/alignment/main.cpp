@@ -0,0 +1,36 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/alignment.hpp>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file> [<buffer-size>]" << std::endl;
+        return 1;
+    }
+
+    analysis::alignment_config config;
+    if (argc > 2) {
+        config.buffer_size = std::stoull(argv[2]);
+    }
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    std::size_t set_idx = 0;
+    for (const auto& set : io_sets)
+    {
+        std::cout << "Set " << set_idx++ << "\n";
+        for (const auto& file : analysis::analyze_alignment(graph, set, config))
+        {
+            std::cout << file << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
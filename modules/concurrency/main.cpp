@@ -0,0 +1,26 @@
+#include <rabbitxx/graph.hpp>
+#include <rabbitxx/analysis/concurrency.hpp>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file> [<bin-width-us>]" << std::endl;
+        return 1;
+    }
+    const auto bin_width = otf2::chrono::microseconds(argc > 2 ? std::stoll(argv[2]) : 1000);
+
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+
+    std::cout << "fs,bin_start_us,mean_ops,max_ops,mean_procs,max_procs,mean_files,max_files,bandwidth\n";
+    for (const auto& profile : analysis::concurrency_over_time(graph,
+                std::chrono::duration_cast<otf2::chrono::duration>(bin_width)))
+    {
+        std::cout << profile;
+    }
+
+    return EXIT_SUCCESS;
+}
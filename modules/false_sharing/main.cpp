@@ -0,0 +1,65 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/false_sharing.hpp>
+
+using namespace rabbitxx;
+
+// <fs>=<block-size>[:<stripe-count>]
+bool parse_layout(const std::string& arg, analysis::stripe_config& config)
+{
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        return false;
+    }
+    try
+    {
+        analysis::fs_layout layout;
+        const auto colon = arg.find(':', eq);
+        layout.block_size = std::stoull(arg.substr(eq + 1, colon - eq - 1));
+        if (colon != std::string::npos) {
+            layout.stripe_count = std::stoull(arg.substr(colon + 1));
+        }
+        config.per_fs[arg.substr(0, eq)] = layout;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file> [<fs>=<block-size>[:<stripe-count>] ...]" << std::endl;
+        return 1;
+    }
+
+    auto config = analysis::default_stripe_config();
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!parse_layout(argv[i], config))
+        {
+            std::cerr << "Error invalid layout: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    std::size_t set_idx = 0;
+    for (const auto& set : io_sets)
+    {
+        std::cout << "Set " << set_idx++ << "\n";
+        for (const auto& file : analysis::analyze_false_sharing(graph, set, config))
+        {
+            std::cout << file << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
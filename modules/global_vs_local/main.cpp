@@ -25,8 +25,9 @@ std::string classify_fs(const std::string& str)
  */
 std::string get_fs_from_file(const IoGraph& graph, const std::string& filename)
 {
-    auto fs_map = graph.graph_properties().file_to_fs;
-    return fs_map[filename];
+    const auto& fs_map = graph.graph_properties().file_to_fs;
+    const auto fs = fs_map.find(filename);
+    return fs != fs_map.end() ? fs->second : std::string();
 }
 
 std::vector<VertexDescriptor>
@@ -0,0 +1,28 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/imbalance.hpp>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file> [<top-n>]" << std::endl;
+        return 1;
+    }
+    const std::size_t top_n = argc > 2 ? std::stoul(argv[2]) : 3;
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    const auto imbalances = analysis::analyze_imbalance(graph, io_sets, top_n);
+    for (std::size_t i = 0; i < imbalances.size(); ++i)
+    {
+        std::cout << "Set " << i << " " << imbalances[i] << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/metadata.hpp>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file> [<window-ms>] [<prefix-depth>]" << std::endl;
+        return 1;
+    }
+
+    analysis::metadata_config config;
+    if (argc > 2) {
+        const auto window_ms = std::stoll(argv[2]);
+        if (window_ms <= 0)
+        {
+            std::cerr << "Error: the window must be positive" << std::endl;
+            return 1;
+        }
+        config.window = std::chrono::duration_cast<otf2::chrono::duration>(
+                std::chrono::milliseconds(window_ms));
+    }
+    if (argc > 3) {
+        config.prefix_depth = std::stoul(argv[3]);
+    }
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    const auto trie = analysis::make_directory_trie(graph);
+    std::size_t set_idx = 0;
+    for (const auto& set : io_sets)
+    {
+        const auto res = analysis::analyze_metadata(graph, trie, set, config);
+        std::cout << "Set " << set_idx++ << "\n";
+        for (const auto& dir : res.directories)
+        {
+            std::cout << "directory " << dir << "\n";
+        }
+        for (const auto& prefix : res.prefixes)
+        {
+            std::cout << "prefix " << prefix << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
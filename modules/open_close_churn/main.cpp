@@ -0,0 +1,28 @@
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/churn.hpp>
+
+using namespace rabbitxx;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Error usage: " << argv[0]
+                << " <trace-file>" << std::endl;
+        return 1;
+    }
+
+    // create graph
+    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(argv[1]);
+    // find concurrent I/O-Sets
+    auto io_sets = find_cio_sets(graph);
+
+    std::cout << "Application\n" << analysis::analyze_churn(graph);
+    std::size_t set_idx = 0;
+    for (const auto& set : io_sets)
+    {
+        std::cout << "Set " << set_idx++ << "\n" << analysis::analyze_churn(graph, set);
+    }
+
+    return EXIT_SUCCESS;
+}
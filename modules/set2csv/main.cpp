@@ -1,4 +1,5 @@
 #include <rabbitxx/experiment.hpp>
+#include <rabbitxx/csv.hpp>
 
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
@@ -17,49 +18,6 @@
 using namespace rabbitxx;
 namespace po = boost::program_options;
 
-// get microseconds as floating point values
-using FpMicroseconds = std::chrono::duration<double, std::micro>;
-// get milliseconds as floating point values
-using FpMilliseconds = std::chrono::duration<double, std::milli>;
-// get seconds as floating point values
-//using FpSeconds = std::chrono::duration<double, std::ratio<1, 1000000000000>>;
-using FpSeconds = std::chrono::duration<double>;
-
-static double calculate_bandwidth(const io_event_property& io_evt)
-{
-    if (std::numeric_limits<std::uint64_t>::max() == io_evt.response_size) {
-        logging::debug() << "Warn, response size is int MAX return 0.0";
-        return 0.0;
-    }
-
-    // throw an exception if my duration is less than zero
-    auto dur_in_sec = std::chrono::duration_cast<FpSeconds>(*io_evt.iop_duration);
-    // can we convert the unit in a type-safe manner?
-    auto mb_rs = (io_evt.response_size / 1024.) / 1024.;
-    double bw = mb_rs / dur_in_sec.count();
-
-    return bw;
-}
-
-void header(std::ostream& os=std::cout)
-{
-    std::array<const char*, 12> columns {
-        "pid,",
-        "filename,",
-        "region_name,",
-        "paradigm,",
-        "request_size,",
-        "response_size,",
-        "offset,",
-        "option,",
-        "kind,",
-        "duration,",
-        "bandwidth(MB/s),",
-        "timestamp"};
-    std::copy(columns.begin(), columns.end(), std::ostream_iterator<const char*>(os, ""));
-    os << "\n";
-}
-
 struct option_csv_printer : boost::static_visitor<std::string>
 {
     std::string operator()(const io_operation_option_container& option) const
@@ -90,56 +48,6 @@ struct option_csv_printer : boost::static_visitor<std::string>
     }
 };
 
-// TODO do that also for other options
-std::string get_option(const io_event_property& io_evt)
-{
-    switch (io_evt.kind)
-    {
-        case io_event_kind::seek:
-            return to_string(
-                    boost::get<otf2::common::io_seek_option_type>(io_evt.option));
-        default:
-            return "None";
-    }
-}
-
-std::ostream& io_event_2_csv_stream(const IoGraph& graph, const VertexDescriptor& evt, std::ostream& out)
-{
-    const auto& io_evt = get_io_property(graph, evt);
-    out << io_evt.proc_id << ", "
-        << io_evt.filename << ", "
-        << io_evt.region_name << ", "
-        << io_evt.paradigm << ", "
-        << io_evt.request_size << ", "
-        << io_evt.response_size << ", "
-        << io_evt.offset << ", "
-        //<< boost::apply_visitor(option_csv_printer(), evt.option) << ", "
-        << get_option(io_evt) << ", "
-        << io_evt.kind << ", "
-        << std::chrono::duration_cast<FpMicroseconds>(graph[evt].duration.duration).count() << ", ";
-
-    if (io_evt.iop_duration) {
-        auto bw_mbs = calculate_bandwidth(io_evt);
-        out << bw_mbs << ", ";
-    }
-    else {
-        out << "None, ";
-    }
-    out << io_evt.timestamp;
-
-    return out;
-}
-
-void set2csv(const IoGraph& graph, const set_t<VertexDescriptor>& set, std::ostream& out=std::cout)
-{
-    header(out);
-    for (auto evt : set)
-    {
-        io_event_2_csv_stream(graph, evt, out);
-        out << "\n";
-    }
-}
-
 static std::string create_cio_set_stats_filename(std::uint64_t sidx)
 {
     std::stringstream sstr;
@@ -181,6 +89,12 @@ void cio_stats_2_csv(const CIO_Stats& stats, std::ostream& out)
     // one comma to much
     std::copy(set_durs.begin(), set_durs.end(),
             std::ostream_iterator<otf2::chrono::duration>(out, ","));
+    out << "\n"
+        << "Set Bandwidths,";
+    for (const auto& bw : stats.get_set_bandwidths())
+    {
+        out << bw.total.bandwidth() << ",";
+    }
     out << "\n";
 }
 
@@ -231,6 +145,60 @@ void graph_stats_to_json(const Graph_Stats& stats, JsonWriter& writer)
     writer.EndObject();
 }
 
+// busy time in microseconds, bandwidth in bytes per second
+template<typename JsonWriter>
+void effective_bandwidth_to_json(const analysis::effective_bandwidth& bw, JsonWriter& writer)
+{
+    writer.StartObject();
+    writer.Key("Bytes");
+    writer.Uint64(bw.bytes);
+    writer.Key("Busy time");
+    writer.Uint64(
+            std::chrono::duration_cast<otf2::chrono::microseconds>(bw.busy_time)
+            .count());
+    writer.Key("Bandwidth");
+    writer.Double(bw.bandwidth());
+    writer.EndObject();
+}
+
+template<typename JsonWriter>
+void set_bandwidth_to_json(const analysis::set_bandwidth& bw, JsonWriter& writer)
+{
+    writer.StartObject();
+    writer.Key("Total");
+    effective_bandwidth_to_json(bw.total, writer);
+    writer.Key("Files");
+    writer.StartObject();
+    for (const auto& kvp : bw.per_file)
+    {
+        writer.Key(kvp.first.c_str());
+        effective_bandwidth_to_json(kvp.second, writer);
+    }
+    writer.EndObject();
+    writer.Key("File systems");
+    writer.StartObject();
+    for (const auto& kvp : bw.per_fs)
+    {
+        writer.Key(kvp.first.c_str());
+        effective_bandwidth_to_json(kvp.second, writer);
+    }
+    writer.EndObject();
+    writer.Key("Processes");
+    writer.StartObject();
+    writer.Key("Count");
+    writer.Uint64(bw.per_process.num_procs);
+    writer.Key("Min");
+    writer.Double(bw.per_process.min);
+    writer.Key("Median");
+    writer.Double(bw.per_process.median);
+    writer.Key("Max");
+    writer.Double(bw.per_process.max);
+    writer.Key("Mean");
+    writer.Double(bw.per_process.mean);
+    writer.EndObject();
+    writer.EndObject();
+}
+
 template<typename JsonWriter>
 void cio_stats_to_json(const CIO_Stats& stats, JsonWriter& writer)
 {
@@ -252,6 +220,13 @@ void cio_stats_to_json(const CIO_Stats& stats, JsonWriter& writer)
                 .count());
     }
     writer.EndArray();
+    writer.Key("Set bandwidths");
+    writer.StartArray();
+    for (const auto& bw : stats.get_set_bandwidths())
+    {
+        set_bandwidth_to_json(bw, writer);
+    }
+    writer.EndArray();
     writer.EndObject();
 }
 
@@ -294,6 +269,94 @@ void clock_properties_to_json(const otf2::definition::clock_properties& clock_pr
     writer.EndObject();
 }
 
+template<typename JsonWriter>
+void profile_entry_to_json(const profile& prof, std::size_t idx, JsonWriter& writer)
+{
+    const auto& entry = prof[idx];
+    writer.StartObject();
+    writer.Key("Name");
+    writer.String(entry.name.c_str());
+    writer.Key("Calls");
+    writer.Uint64(entry.calls);
+    writer.Key("Wall time");
+    writer.Uint64(std::chrono::duration_cast<std::chrono::microseconds>(entry.wall).count());
+    writer.Key("CPU time");
+    writer.Uint64(std::chrono::duration_cast<std::chrono::microseconds>(entry.cpu).count());
+    writer.Key("Peak RSS delta");
+    writer.Uint64(entry.peak_rss_delta);
+    if (profiler::counts_allocations())
+    {
+        writer.Key("Allocations");
+        writer.Uint64(entry.allocations);
+        writer.Key("Allocated bytes");
+        writer.Uint64(entry.allocated_bytes);
+    }
+    writer.Key("Children");
+    writer.StartArray();
+    for (const auto child : prof.children(idx))
+    {
+        profile_entry_to_json(prof, child, writer);
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
+template<typename JsonWriter>
+void callback_counts_to_json(const graph::callback_counts& counts, JsonWriter& writer)
+{
+    writer.StartObject();
+    writer.Key("Seen");
+    writer.Uint64(counts.seen);
+    writer.Key("Filtered");
+    writer.Uint64(counts.filtered);
+    writer.Key("Converted");
+    writer.Uint64(counts.converted);
+    writer.Key("Bytes");
+    writer.Uint64(counts.bytes);
+    writer.Key("Time");
+    writer.Uint64(std::chrono::duration_cast<std::chrono::microseconds>(counts.time).count());
+    writer.EndObject();
+}
+
+// times in microseconds, callbacks without events are omitted
+template<typename JsonWriter>
+void ingestion_to_json(const graph::ingestion_summary& ingestion, JsonWriter& writer)
+{
+    writer.StartObject();
+    writer.Key("Expected events");
+    writer.Uint64(ingestion.expected_events);
+    writer.Key("Elapsed");
+    writer.Uint64(std::chrono::duration_cast<std::chrono::microseconds>(ingestion.elapsed).count());
+    writer.Key("Events per second");
+    writer.Double(ingestion.events_per_second());
+    writer.Key("Total");
+    callback_counts_to_json(ingestion.total(), writer);
+    writer.Key("Callbacks");
+    writer.StartObject();
+    for (std::size_t i = 0; i < ingestion.per_type.size(); ++i)
+    {
+        if (ingestion.per_type[i].seen == 0) {
+            continue;
+        }
+        writer.Key(graph::to_string(static_cast<graph::callback_type>(i)));
+        callback_counts_to_json(ingestion.per_type[i], writer);
+    }
+    writer.EndObject();
+    writer.EndObject();
+}
+
+// times in microseconds, memory in bytes
+template<typename JsonWriter>
+void profile_to_json(const profile& prof, JsonWriter& writer)
+{
+    writer.StartArray();
+    for (const auto idx : prof.children(profile_entry::no_parent))
+    {
+        profile_entry_to_json(prof, idx, writer);
+    }
+    writer.EndArray();
+}
+
 void experiment_stats_to_json(const Experiment_Stats& stats, std::ostream& out)
 {
     rapidjson::OStreamWrapper osw(out);
@@ -317,6 +380,10 @@ void experiment_stats_to_json(const Experiment_Stats& stats, std::ostream& out)
     file_system_map_to_json(stats.file_system_map(), writer);
     writer.Key("Clock Properties");
     clock_properties_to_json(stats.clock_properties(), writer);
+    writer.Key("Ingestion");
+    ingestion_to_json(stats.ingestion(), writer);
+    writer.Key("Profile");
+    profile_to_json(stats.phase_profile(), writer);
     writer.EndObject();
 }
 
@@ -331,18 +398,24 @@ void csv_output(const Experiment::experiment_results& res,
         const experiment_config& config,
         const fs::path& base_path)
 {
-    if (config.pio_sets)
-    {
-        pio_sets_2_csv(res.graph, res.pio_sets, base_path / "pio-sets");
-    }
-    if (config.cio_sets)
     {
-        sets_2_csv(res.graph, res.cio_sets, base_path /  "cio-sets");
+        profile_scope scope("output");
+        if (config.pio_sets)
+        {
+            pio_sets_2_csv(res.graph, res.pio_sets, base_path / "pio-sets");
+        }
+        if (config.cio_sets)
+        {
+            sets_2_csv(res.graph, res.cio_sets, base_path /  "cio-sets");
+        }
     }
     if (config.with_summary)
     {
-        summary_2_csv(stats, base_path);
-        summary_to_json(stats, base_path);
+        // include the output phase in the summary
+        auto summary = stats;
+        summary.set_profile(profiler::global().result());
+        summary_2_csv(summary, base_path);
+        summary_to_json(summary, base_path);
     }
 }
 
@@ -354,6 +427,20 @@ int main(int argc, char** argv)
     bool with_summary = true;
     bool cio_set_out = true;
     bool pio_set_out = false;
+    bool compact_io = false;
+    bool filter_pseudo_files = false;
+    std::vector<std::string> excluded_prefixes;
+    std::vector<std::string> paradigms;
+    double window_begin = -1.0;
+    double window_end = -1.0;
+    std::vector<std::uint64_t> locations;
+    std::string presize = "none";
+    std::uint64_t presize_budget = 1024;
+    bool estimate_only = false;
+    double progress_interval = 0.0;
+    bool all_layers = false;
+    bool aggregate_collective_io = false;
+    std::string layer;
     bool debug = false;
 
     po::options_description description("set2csv - Output CIO-Sets as csv");
@@ -377,6 +464,49 @@ int main(int argc, char** argv)
         ("pio-sets,p",
             po::bool_switch(&pio_set_out)->default_value(false),
             "Output PIO-Sets, local sets per-process")
+        ("compact-io",
+            po::bool_switch(&compact_io)->default_value(false),
+            "Fold back-to-back reads/writes on the same file into one event")
+        ("filter-pseudo-files",
+            po::bool_switch(&filter_pseudo_files)->default_value(false),
+            "Drop accesses to /proc, /sys, /dev, /etc, stdout, ... during construction")
+        ("exclude-prefix",
+            po::value<std::vector<std::string>>(&excluded_prefixes)->composing(),
+            "Drop accesses to paths starting with the given prefix")
+        ("paradigm",
+            po::value<std::vector<std::string>>(&paradigms)->composing(),
+            "Keep only I/O of the given paradigm, e.g. POSIX")
+        ("window-begin",
+            po::value<double>(&window_begin),
+            "Ignore events before this point in time, in seconds since trace start")
+        ("window-end",
+            po::value<double>(&window_end),
+            "Ignore events after this point in time, in seconds since trace start")
+        ("location",
+            po::value<std::vector<std::uint64_t>>(&locations)->composing(),
+            "Read only the events of the given location, can be given multiple times")
+        ("presize",
+            po::value<std::string>(&presize)->default_value("none"),
+            "Reserve the graph storage up front: none, definitions or count, "
+            "count reads the trace twice")
+        ("presize-budget",
+            po::value<std::uint64_t>(&presize_budget)->default_value(1024),
+            "Reserve at most this many MiB up front")
+        ("estimate",
+            po::bool_switch(&estimate_only)->default_value(false),
+            "Print the estimated graph size and memory consumption and exit")
+        ("progress",
+            po::value<double>(&progress_interval)->default_value(0.0),
+            "Log the reading progress every given number of seconds, 0 disables it")
+        ("all-layers",
+            po::bool_switch(&all_layers)->default_value(false),
+            "Keep the I/O of all paradigms, e.g. HDF5, MPI-IO and POSIX, in one graph")
+        ("aggregate-collective-io",
+            po::bool_switch(&aggregate_collective_io)->default_value(false),
+            "Add one vertex per collective MPI-IO call, linked to the events of its processes")
+        ("layer",
+            po::value<std::string>(&layer),
+            "Compute the sets from the I/O of this paradigm only, e.g. MPI-IO")
         ("trace-file",
             po::value<fs::path>(&trc_file),
             "Input trace file *.otf2")
@@ -404,6 +534,12 @@ int main(int argc, char** argv)
         log::set_min_severity_level(
                 nitro::log::severity_level::debug);
     }
+    else if (progress_interval > 0.0)
+    {
+        // progress reports are info messages
+        log::set_min_severity_level(
+                nitro::log::severity_level::info);
+    }
     else
     {
         log::set_min_severity_level(
@@ -429,6 +565,48 @@ int main(int argc, char** argv)
     }
 
     experiment_config e_conf {with_summary, pio_set_out, cio_set_out};
+    e_conf.builder.compact_io = compact_io;
+    if (filter_pseudo_files)
+    {
+        e_conf.builder.filter = filter_spec::pseudo_files();
+    }
+    for (const auto& prefix : excluded_prefixes)
+    {
+        e_conf.builder.filter.excluded_paths.insert(prefix);
+    }
+    e_conf.builder.filter.allowed_paradigms.insert(paradigms.begin(), paradigms.end());
+    // otf2xx time points are relative to the trace start
+    auto seconds_to_tp = [](double secs) {
+        return otf2::chrono::time_point(std::chrono::duration_cast<otf2::chrono::duration>(
+                    std::chrono::duration<double>(secs)));
+    };
+    if (vm.count("window-begin"))
+    {
+        e_conf.builder.window_begin = seconds_to_tp(window_begin);
+    }
+    if (vm.count("window-end"))
+    {
+        e_conf.builder.window_end = seconds_to_tp(window_end);
+    }
+    e_conf.builder.locations.insert(locations.begin(), locations.end());
+    e_conf.builder.progress_interval = progress_interval;
+    e_conf.builder.keep_all_layers = all_layers;
+    e_conf.builder.aggregate_collective_io = aggregate_collective_io;
+    e_conf.layer = layer;
+    e_conf.builder.presize_budget_mib = presize_budget;
+    if (presize == "definitions")
+    {
+        e_conf.builder.presize = graph::presize_mode::definitions;
+    }
+    else if (presize == "count")
+    {
+        e_conf.builder.presize = graph::presize_mode::count;
+    }
+    else if (presize != "none")
+    {
+        logging::error() << "unknown presize mode: " << presize;
+        return EXIT_FAILURE;
+    }
     logging::debug() << "created config: " << e_conf;
 
     if (vm.count("out-dir"))
@@ -445,6 +623,15 @@ int main(int argc, char** argv)
     }
 
     logging::debug() << "using tracefile: " << trc_file.string();
+    if (estimate_only)
+    {
+        auto conf = e_conf.builder;
+        if (conf.presize == graph::presize_mode::none) {
+            conf.presize = graph::presize_mode::definitions;
+        }
+        std::cout << graph::estimate_graph_size(trc_file.string(), conf) << std::endl;
+        return EXIT_SUCCESS;
+    }
     //Experiment exp(trc_file); // just trace file use default config
     Experiment exp(trc_file, base_path, experiment_name, e_conf);
     auto stats = exp.run(csv_output);
@@ -0,0 +1,197 @@
+#include <rabbitxx/analysis/access_pattern.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <unordered_map>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+/**
+ * Incremental classification of one stream, O(1) per access.
+ */
+class stream_classifier
+{
+public:
+    stream_classifier(std::uint64_t proc_id, const std::string& filename)
+    {
+        result_.proc_id = proc_id;
+        result_.filename = filename;
+    }
+
+    void add(std::uint64_t begin, std::uint64_t size)
+    {
+        if (result_.num_ops == 0) {
+            result_.min_size = size;
+            result_.max_size = size;
+        }
+        ++result_.num_ops;
+        result_.bytes += size;
+        result_.min_size = std::min(result_.min_size, size);
+        result_.max_size = std::max(result_.max_size, size);
+        ++result_.size_histogram[size_class(size)];
+
+        if (result_.num_ops > 1) {
+            add_delta(begin, static_cast<std::int64_t>(begin) - static_cast<std::int64_t>(prev_begin_));
+        }
+        prev_begin_ = begin;
+        prev_end_ = begin + size;
+    }
+
+    stream_pattern finish()
+    {
+        auto& res = result_;
+        if (res.num_ops > 1) {
+            res.contiguity = static_cast<double>(num_contiguous_) / (res.num_ops - 1);
+        }
+        if (num_strides_ == 1) {
+            res.stride = strides_[0];
+        }
+
+        if (res.num_ops <= 1 || num_contiguous_ == res.num_ops - 1) {
+            res.pattern = access_pattern::contiguous;
+        }
+        else if (num_strides_ == 1) {
+            res.pattern = access_pattern::strided;
+        }
+        else if (num_strides_ == 2 && !too_many_strides_ && !irregular_) {
+            res.pattern = access_pattern::nested_strided;
+            res.stride = strides_[0];
+            res.outer_stride = strides_[1];
+            // accesses per inner run, the first run might have been cut
+            res.inner_count = (num_outer_ > 1 ? expected_run_ : std::max(first_run_, run_)) + 1;
+        }
+        else {
+            res.pattern = access_pattern::random;
+        }
+        return res;
+    }
+
+private:
+    void add_delta(std::uint64_t begin, std::int64_t delta)
+    {
+        if (begin == prev_end_) {
+            ++num_contiguous_;
+        }
+
+        const auto end = strides_ + num_strides_;
+        if (std::find(strides_, end, delta) == end)
+        {
+            if (num_strides_ < 2) {
+                strides_[num_strides_++] = delta;
+            }
+            else {
+                too_many_strides_ = true;
+            }
+        }
+
+        // runs of the inner stride, the first stride seen, separated by
+        // single outer strides must have the same length.
+        if (delta == strides_[0]) {
+            ++run_;
+            return;
+        }
+        ++num_outer_;
+        if (num_outer_ == 1) {
+            first_run_ = run_;
+        }
+        else if (num_outer_ == 2) {
+            expected_run_ = run_;
+            irregular_ = irregular_ || first_run_ > expected_run_;
+        }
+        else if (run_ != expected_run_) {
+            irregular_ = true;
+        }
+        run_ = 0;
+    }
+
+    stream_pattern result_;
+    std::uint64_t prev_begin_ = 0;
+    std::uint64_t prev_end_ = 0;
+    std::uint64_t num_contiguous_ = 0;
+    std::int64_t strides_[2] = { 0, 0 };
+    std::size_t num_strides_ = 0;
+    bool too_many_strides_ = false;
+    std::uint64_t run_ = 0;
+    std::uint64_t first_run_ = 0;
+    std::uint64_t expected_run_ = 0;
+    std::uint64_t num_outer_ = 0;
+    bool irregular_ = false;
+};
+
+} // namespace
+
+const char* to_string(access_pattern pattern)
+{
+    switch (pattern)
+    {
+        case access_pattern::contiguous: return "contiguous";
+        case access_pattern::strided: return "strided";
+        case access_pattern::nested_strided: return "nested-strided";
+        case access_pattern::random: return "random";
+    }
+    return "invalid";
+}
+
+std::ostream& operator<<(std::ostream& os, access_pattern pattern)
+{
+    return os << to_string(pattern);
+}
+
+std::ostream& operator<<(std::ostream& os, const stream_pattern& stream)
+{
+    const auto flags = os.flags();
+    os << "process: " << stream.proc_id
+        << " file: " << stream.filename
+        << " pattern: " << stream.pattern
+        << " ops: " << stream.num_ops
+        << " bytes: " << stream.bytes
+        << " stride: " << stream.stride;
+    if (stream.pattern == access_pattern::nested_strided) {
+        os << " outer stride: " << stream.outer_stride
+            << " inner count: " << stream.inner_count;
+    }
+    os << " contiguity: " << std::fixed << std::setprecision(2) << stream.contiguity
+        << " size: [" << stream.min_size << ", " << stream.max_size << "] histogram:";
+    for (const auto& kvp : stream.size_histogram)
+    {
+        os << " <=" << kvp.first << ":" << kvp.second;
+    }
+    os.flags(flags);
+    return os;
+}
+
+std::vector<stream_pattern> classify_access_patterns(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set)
+{
+    std::unordered_map<stream_key, stream_classifier, stream_key_hash> streams;
+    for (const auto vd : cio_set)
+    {
+        const auto& io = boost::get<io_event_property>(graph[vd].property);
+        if (!is_data_access(io)) {
+            continue;
+        }
+        auto key = stream_key { io.proc_id, io.filename };
+        auto it = streams.find(key);
+        if (it == streams.end()) {
+            it = streams.emplace(key, stream_classifier(io.proc_id, io.filename)).first;
+        }
+        it->second.add(begin_offset(io), io.response_size);
+    }
+
+    std::vector<stream_pattern> result;
+    result.reserve(streams.size());
+    for (auto& kvp : streams)
+    {
+        result.push_back(kvp.second.finish());
+    }
+    std::sort(result.begin(), result.end(),
+            [](const stream_pattern& a, const stream_pattern& b) {
+                return a.proc_id != b.proc_id ? a.proc_id < b.proc_id : a.filename < b.filename;
+            });
+    return result;
+}
+
+}} // namespace rabbitxx::analysis
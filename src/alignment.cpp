@@ -0,0 +1,171 @@
+#include <rabbitxx/analysis/alignment.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+struct stream_counts
+{
+    std::uint64_t num_ops = 0;
+    std::uint64_t small_unaligned_ops = 0;
+    std::uint64_t bytes = 0;
+};
+
+/**
+ * @brief Per-file accumulators, including the sums of the least squares fit
+ * of duration against request size.
+ */
+struct file_counts
+{
+    file_alignment result;
+    std::map<std::uint64_t, stream_counts> streams;
+    double num_timed = 0;
+    double sum_size = 0;
+    double sum_time = 0;
+    double sum_size_sq = 0;
+    double sum_size_time = 0;
+
+    void add(std::uint64_t proc_id, std::uint64_t offset, std::uint64_t size,
+            const boost::optional<otf2::chrono::duration>& duration)
+    {
+        auto& res = result;
+        const auto aligned = offset % res.block_size == 0;
+        const auto small = size < res.block_size;
+        ++res.num_ops;
+        res.bytes += size;
+        res.aligned_ops += aligned;
+        res.small_ops += small;
+        res.small_unaligned_ops += small && !aligned;
+        ++res.size_histogram[size_class(size)];
+        // lowest set bit of the offset
+        const auto alignment = offset == 0 ? res.block_size : std::min(offset & (~offset + 1), res.block_size);
+        ++res.alignment_histogram[alignment];
+
+        auto& stream = streams[proc_id];
+        ++stream.num_ops;
+        stream.small_unaligned_ops += small && !aligned;
+        stream.bytes += size;
+
+        if (duration)
+        {
+            res.io_time += *duration;
+            const auto x = static_cast<double>(size);
+            const auto y = static_cast<double>(duration->count());
+            ++num_timed;
+            sum_size += x;
+            sum_time += y;
+            sum_size_sq += x * x;
+            sum_size_time += x * y;
+        }
+    }
+
+    void finish(double small_unaligned_fraction)
+    {
+        auto& res = result;
+        for (const auto& kvp : streams)
+        {
+            const auto& stream = kvp.second;
+            res.aggregated_ops += std::max<std::uint64_t>(1,
+                    (stream.bytes + res.buffer_size - 1) / res.buffer_size);
+            if (stream.small_unaligned_ops >= small_unaligned_fraction * stream.num_ops) {
+                res.flagged_procs.push_back(kvp.first);
+            }
+        }
+        if (num_timed == 0) {
+            return;
+        }
+
+        // time = latency + size * per_byte
+        const auto mean_size = sum_size / num_timed;
+        const auto mean_time = sum_time / num_timed;
+        const auto var = sum_size_sq / num_timed - mean_size * mean_size;
+        double per_byte = 0;
+        if (var > 0) {
+            per_byte = std::max(0.0, (sum_size_time / num_timed - mean_size * mean_time) / var);
+        }
+        auto latency = mean_time - per_byte * mean_size;
+        if (latency < 0 && sum_size > 0) {
+            latency = 0;
+            per_byte = sum_time / sum_size;
+        }
+        const auto estimate = res.aggregated_ops * latency + res.bytes * per_byte;
+        res.aggregated_time = otf2::chrono::duration(static_cast<otf2::chrono::duration::rep>(estimate));
+    }
+};
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const file_alignment& file)
+{
+    os << "file: " << file.filename
+        << " fs: " << file.file_system
+        << " block size: " << file.block_size
+        << " ops: " << file.num_ops
+        << " bytes: " << file.bytes
+        << " aligned: " << file.aligned_ops
+        << " small: " << file.small_ops
+        << " small unaligned: " << file.small_unaligned_ops
+        << " sizes:";
+    for (const auto& kvp : file.size_histogram)
+    {
+        os << " <=" << kvp.first << ":" << kvp.second;
+    }
+    os << " alignments:";
+    for (const auto& kvp : file.alignment_histogram)
+    {
+        os << " " << kvp.first << ":" << kvp.second;
+    }
+    os << " flagged processes:";
+    for (const auto proc : file.flagged_procs)
+    {
+        os << " " << proc;
+    }
+    return os << " buffer size: " << file.buffer_size
+        << " saved ops: " << file.saved_ops()
+        << " saved time: " << file.saved_time().count()
+        << " of " << file.io_time.count();
+}
+
+std::vector<file_alignment> analyze_alignment(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set,
+        const alignment_config& config)
+{
+    const auto& file_to_fs = graph.graph_properties().file_to_fs;
+    std::map<std::string, file_counts> files;
+    for (const auto vd : cio_set)
+    {
+        const auto& io = boost::get<io_event_property>(graph[vd].property);
+        if (!is_data_access(io)) {
+            continue;
+        }
+        auto it = files.find(io.filename);
+        if (it == files.end())
+        {
+            file_counts counts;
+            auto& res = counts.result;
+            res.filename = io.filename;
+            const auto fs = file_to_fs.find(io.filename);
+            if (fs != file_to_fs.end()) {
+                res.file_system = fs->second;
+            }
+            res.block_size = std::max<std::uint64_t>(config.layouts.layout(res.file_system).block_size, 1);
+            res.buffer_size = config.buffer_size > 0 ? config.buffer_size : res.block_size;
+            it = files.emplace(io.filename, std::move(counts)).first;
+        }
+        it->second.add(io.proc_id, begin_offset(io), io.response_size, io.iop_duration);
+    }
+
+    std::vector<file_alignment> result;
+    result.reserve(files.size());
+    for (auto& kvp : files)
+    {
+        kvp.second.finish(config.small_unaligned_fraction);
+        result.push_back(std::move(kvp.second.result));
+    }
+    return result;
+}
+
+}} // namespace rabbitxx::analysis
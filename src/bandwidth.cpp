@@ -0,0 +1,209 @@
+#include <rabbitxx/analysis/bandwidth.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+#include <rabbitxx/analysis/parallel_sort.hpp>
+
+#include <numeric>
+#include <unordered_map>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+bool by_begin(const busy_interval& a, const busy_interval& b)
+{
+    return a.begin < b.begin;
+}
+
+/**
+ * @brief Interval of a read or write, within one of the groups of a set.
+ */
+struct tagged_interval
+{
+    busy_interval span;
+    std::uint64_t proc_id;
+    std::uint32_t file;
+    std::uint64_t bytes;
+};
+
+/**
+ * @brief Union of intervals added in the order of their begin.
+ */
+class union_accumulator
+{
+public:
+    void add(const busy_interval& interval)
+    {
+        if (!open_)
+        {
+            current_ = interval;
+            open_ = true;
+            return;
+        }
+        if (interval.begin > current_.end)
+        {
+            closed_ += current_.end - current_.begin;
+            current_ = interval;
+            return;
+        }
+        current_.end = std::max(current_.end, interval.end);
+    }
+
+    otf2::chrono::duration length() const
+    {
+        return open_ ? closed_ + (current_.end - current_.begin) : closed_;
+    }
+
+private:
+    busy_interval current_;
+    otf2::chrono::duration closed_ {0};
+    bool open_ = false;
+};
+
+/**
+ * @brief Bytes and busy time of one group of intervals.
+ */
+struct bandwidth_accumulator
+{
+    union_accumulator busy;
+    std::uint64_t bytes = 0;
+
+    void add(const busy_interval& interval, std::uint64_t num_bytes)
+    {
+        busy.add(interval);
+        bytes += num_bytes;
+    }
+
+    effective_bandwidth result() const
+    {
+        return effective_bandwidth { bytes, busy.length() };
+    }
+};
+
+bandwidth_distribution distribution(std::vector<double> values)
+{
+    bandwidth_distribution dist;
+    dist.num_procs = values.size();
+    if (values.empty()) {
+        return dist;
+    }
+    std::sort(values.begin(), values.end());
+    dist.min = values.front();
+    dist.max = values.back();
+    const auto mid = values.size() / 2;
+    dist.median = values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+    dist.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    return dist;
+}
+
+} // namespace
+
+otf2::chrono::duration union_length(const std::vector<busy_interval>& intervals)
+{
+    union_accumulator acc;
+    for (const auto& interval : intervals)
+    {
+        acc.add(interval);
+    }
+    return acc.length();
+}
+
+otf2::chrono::duration busy_time(std::vector<busy_interval> intervals)
+{
+    parallel_sort(intervals.begin(), intervals.end(), by_begin);
+    return union_length(intervals);
+}
+
+std::ostream& operator<<(std::ostream& os, const set_bandwidth& bw)
+{
+    os << "bytes: " << bw.total.bytes
+        << " busy: " << bw.total.busy_time.count()
+        << " bandwidth: " << bw.total.bandwidth()
+        << " per process: [min: " << bw.per_process.min
+        << " median: " << bw.per_process.median
+        << " max: " << bw.per_process.max
+        << " mean: " << bw.per_process.mean << "]";
+    for (const auto& kvp : bw.per_fs)
+    {
+        os << " " << kvp.first << ": " << kvp.second.bandwidth();
+    }
+    return os;
+}
+
+set_bandwidth analyze_bandwidth(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set)
+{
+    const auto& file_to_fs = graph.graph_properties().file_to_fs;
+    std::unordered_map<std::string, std::uint32_t> file_ids;
+    std::vector<std::string> filenames;
+    std::vector<tagged_interval> intervals;
+    intervals.reserve(cio_set.size());
+    for (const auto vd : cio_set)
+    {
+        const auto& vertex = graph[vd];
+        const auto& io = boost::get<io_event_property>(vertex.property);
+        if (!is_data_access(io)) {
+            continue;
+        }
+        // the region of the call, or the operation itself if the vertex has
+        // no region, the timestamp of an I/O vertex is its completion
+        busy_interval span { vertex.duration.enter, vertex.duration.leave };
+        if (span.begin == otf2::chrono::armageddon() || span.end == otf2::chrono::armageddon())
+        {
+            span.end = io.timestamp;
+            span.begin = io.iop_duration ? io.timestamp - *io.iop_duration : io.timestamp;
+        }
+        auto file = file_ids.find(io.filename);
+        if (file == file_ids.end())
+        {
+            file = file_ids.emplace(io.filename, static_cast<std::uint32_t>(filenames.size())).first;
+            filenames.push_back(io.filename);
+        }
+        intervals.push_back(tagged_interval { span, io.proc_id, file->second, io.response_size });
+    }
+
+    parallel_sort(intervals.begin(), intervals.end(),
+            [](const tagged_interval& a, const tagged_interval& b) { return by_begin(a.span, b.span); });
+
+    // every group sees its intervals in the sorted order
+    bandwidth_accumulator total;
+    std::vector<bandwidth_accumulator> per_file(filenames.size());
+    std::vector<bandwidth_accumulator*> file_fs(filenames.size(), nullptr);
+    std::map<std::string, bandwidth_accumulator> per_fs;
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        const auto fs = file_to_fs.find(filenames[i]);
+        if (fs != file_to_fs.end()) {
+            file_fs[i] = &per_fs[fs->second];
+        }
+    }
+    std::unordered_map<std::uint64_t, bandwidth_accumulator> per_proc;
+    for (const auto& interval : intervals)
+    {
+        total.add(interval.span, interval.bytes);
+        per_file[interval.file].add(interval.span, interval.bytes);
+        if (file_fs[interval.file]) {
+            file_fs[interval.file]->add(interval.span, interval.bytes);
+        }
+        per_proc[interval.proc_id].add(interval.span, interval.bytes);
+    }
+
+    set_bandwidth res;
+    res.total = total.result();
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        res.per_file.emplace(filenames[i], per_file[i].result());
+    }
+    for (const auto& kvp : per_fs)
+    {
+        res.per_fs.emplace(kvp.first, kvp.second.result());
+    }
+    std::vector<double> proc_bandwidths;
+    proc_bandwidths.reserve(per_proc.size());
+    for (const auto& kvp : per_proc)
+    {
+        proc_bandwidths.push_back(kvp.second.result().bandwidth());
+    }
+    res.per_process = distribution(std::move(proc_bandwidths));
+    return res;
+}
+
+}} // namespace rabbitxx::analysis
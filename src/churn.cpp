@@ -0,0 +1,175 @@
+#include <rabbitxx/analysis/churn.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+class churn_builder
+{
+public:
+    explicit churn_builder(const IoGraph& graph) : graph_(graph)
+    {
+    }
+
+    void add(VertexDescriptor vd)
+    {
+        const auto& vertex = graph_[vd];
+        const auto& io = boost::get<io_event_property>(vertex.property);
+        churn_counts delta;
+        const auto time = operation_time(vertex);
+        if (is_data_access(io))
+        {
+            delta.data_ops = 1;
+            delta.bytes = io.response_size;
+            delta.data_time = time;
+        }
+        else
+        {
+            delta.metadata_ops = 1;
+            delta.metadata_time = time;
+        }
+
+        // number of open handles of this process to this file
+        auto& depth = open_[stream_key { io.proc_id, io.filename }];
+        if (io.kind == io_event_kind::create || io.kind == io_event_kind::dup) {
+            ++depth;
+        }
+        else if (io.kind == io_event_kind::delete_or_close)
+        {
+            if (depth == 0) {
+                delta.unmatched_closes = 1;
+            }
+            else if (--depth == 0) {
+                delta.cycles = 1;
+            }
+        }
+
+        total_ += delta;
+        files_[io.filename] += delta;
+        procs_[io.proc_id] += delta;
+    }
+
+    churn_summary finish()
+    {
+        for (const auto& kvp : open_)
+        {
+            if (kvp.second > 0)
+            {
+                ++total_.open_cycles;
+                ++files_[kvp.first.filename].open_cycles;
+                ++procs_[kvp.first.proc_id].open_cycles;
+            }
+        }
+
+        churn_summary res;
+        res.total = total_;
+        res.files.reserve(files_.size());
+        for (const auto& kvp : files_)
+        {
+            res.files.push_back(file_churn { kvp.first, kvp.second });
+        }
+        std::sort(res.files.begin(), res.files.end(),
+                [](const file_churn& a, const file_churn& b) {
+                    return a.counts.metadata_time != b.counts.metadata_time
+                        ? a.counts.metadata_time > b.counts.metadata_time
+                        : a.filename < b.filename;
+                });
+        res.procs.reserve(procs_.size());
+        for (const auto& kvp : procs_)
+        {
+            res.procs.push_back(process_churn { kvp.first, kvp.second });
+        }
+        std::sort(res.procs.begin(), res.procs.end(),
+                [](const process_churn& a, const process_churn& b) { return a.proc_id < b.proc_id; });
+
+        const auto& info = graph_.graph_properties();
+        const auto app_time = (info.io_time + info.io_metadata_time).count();
+        if (app_time > 0) {
+            res.app_metadata_fraction = static_cast<double>(info.io_metadata_time.count()) / app_time;
+        }
+        if (info.io_metadata_time.count() > 0) {
+            res.share_of_app_metadata_time = static_cast<double>(total_.metadata_time.count())
+                / info.io_metadata_time.count();
+        }
+        return res;
+    }
+
+private:
+    const IoGraph& graph_;
+    std::unordered_map<stream_key, std::uint32_t, stream_key_hash> open_;
+    churn_counts total_;
+    std::unordered_map<std::string, churn_counts> files_;
+    std::unordered_map<std::uint64_t, churn_counts> procs_;
+};
+
+} // namespace
+
+churn_counts& churn_counts::operator+=(const churn_counts& other)
+{
+    cycles += other.cycles;
+    unmatched_closes += other.unmatched_closes;
+    open_cycles += other.open_cycles;
+    data_ops += other.data_ops;
+    metadata_ops += other.metadata_ops;
+    bytes += other.bytes;
+    data_time += other.data_time;
+    metadata_time += other.metadata_time;
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const churn_summary& churn)
+{
+    const auto print = [&os](const churn_counts& counts) {
+        os << "cycles: " << counts.cycles
+            << " unmatched closes: " << counts.unmatched_closes
+            << " open: " << counts.open_cycles
+            << " bytes/cycle: " << counts.bytes_per_cycle()
+            << " metadata fraction: " << counts.metadata_fraction();
+    };
+    os << "total ";
+    print(churn.total);
+    os << " app metadata fraction: " << churn.app_metadata_fraction
+        << " share of app metadata time: " << churn.share_of_app_metadata_time << "\n";
+    for (const auto& file : churn.files)
+    {
+        os << "file " << file.filename << " ";
+        print(file.counts);
+        os << "\n";
+    }
+    for (const auto& proc : churn.procs)
+    {
+        os << "process " << proc.proc_id << " ";
+        print(proc.counts);
+        os << "\n";
+    }
+    return os;
+}
+
+churn_summary analyze_churn(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set)
+{
+    churn_builder builder(graph);
+    for (const auto vd : cio_set)
+    {
+        builder.add(vd);
+    }
+    return builder.finish();
+}
+
+churn_summary analyze_churn(const IoGraph& graph)
+{
+    churn_builder builder(graph);
+    const auto vip = graph.vertices();
+    for (auto vit = vip.first; vit != vip.second; ++vit)
+    {
+        if (graph[*vit].type == vertex_kind::io_event) {
+            builder.add(*vit);
+        }
+    }
+    return builder.finish();
+}
+
+}} // namespace rabbitxx::analysis
@@ -1,4 +1,5 @@
 #include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/profiler.hpp>
 
 #include <algorithm>
 #include <numeric>
@@ -183,7 +184,12 @@ find_cio_sets(IoGraph& graph)
 set_container_t<VertexDescriptor>
 find_cio_sets(const IoGraph& graph, set_map_t<VertexDescriptor>& sets_per_process)
 {
-    auto merged_sets = merge_sets(graph, sets_per_process);
+    set_container_t<VertexDescriptor> merged_sets;
+    {
+        profile_scope scope("merge");
+        merged_sets = merge_sets(graph, sets_per_process);
+    }
+    profile_scope scope("dedup");
     //logging::debug() << "Resulting Sets:\n" << "raw size: " << merged_sets.size();
     // remove empty sets
     remove_empty_sets(merged_sets);
@@ -221,6 +227,41 @@ get_io_events_by_kind(const IoGraph& graph, const set_t<VertexDescriptor>& cio_s
     return results;
 }
 
+std::set<std::string>
+io_layers(const IoGraph& graph)
+{
+    std::set<std::string> layers;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type == vertex_kind::io_event) {
+            layers.insert(boost::get<io_event_property>(graph[*it].property).paradigm);
+        }
+    }
+    return layers;
+}
+
+void
+restrict_to_layer(const IoGraph& graph, set_map_t<VertexDescriptor>& sets,
+        const std::string& paradigm)
+{
+    for (auto& proc_sets : sets)
+    {
+        for (auto& set : proc_sets.second)
+        {
+            std::vector<VertexDescriptor> other_layers;
+            std::copy_if(set.begin(), set.end(), std::back_inserter(other_layers),
+                    [&graph, &paradigm](const VertexDescriptor& vd) {
+                        return boost::get<io_event_property>(graph[vd].property).paradigm != paradigm;
+                    });
+            for (const auto vd : other_layers)
+            {
+                set.erase(vd);
+            }
+        }
+    }
+}
+
 namespace detail
 {
 
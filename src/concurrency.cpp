@@ -0,0 +1,264 @@
+#include <rabbitxx/analysis/concurrency.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+#include <rabbitxx/analysis/parallel_sort.hpp>
+
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+using rep = otf2::chrono::duration::rep;
+
+/**
+ * @brief Enter or leave of one I/O operation.
+ */
+struct span_event
+{
+    rep time;
+    std::uint64_t proc_id;
+    std::uint32_t file;
+    // index of the file system profile, 0 is the profile of all of them
+    std::uint32_t fs;
+    // bytes per tick, negative on leave
+    double rate;
+    bool enter;
+};
+
+/**
+ * @brief An operation without duration, its bytes are added to its bin.
+ */
+struct instant
+{
+    rep time;
+    std::uint32_t fs;
+    double bytes;
+};
+
+class sweep_state
+{
+public:
+    explicit sweep_state(concurrency_profile& profile)
+        : profile_(profile),
+          start_(profile.start.time_since_epoch().count()),
+          width_(profile.bin_width.count())
+    {
+    }
+
+    void apply(const span_event& evt)
+    {
+        if (evt.enter)
+        {
+            ++num_ops_;
+            ++procs_[evt.proc_id];
+            ++files_[evt.file];
+            rate_ += evt.rate;
+            return;
+        }
+        --num_ops_;
+        release(procs_, evt.proc_id);
+        release(files_, evt.file);
+        // avoid accumulating rounding errors over idle periods
+        rate_ = num_ops_ > 0 ? rate_ + evt.rate : 0.0;
+    }
+
+    // add the current state to all bins overlapping [from, to)
+    void advance(rep from, rep to)
+    {
+        if (num_ops_ == 0 || to <= from) {
+            return;
+        }
+        auto bin = static_cast<std::size_t>((from - start_) / width_);
+        for (auto pos = from; pos < to; ++bin)
+        {
+            const auto bin_end = start_ + static_cast<rep>(bin + 1) * width_;
+            const auto overlap = std::min(to, bin_end) - pos;
+            const auto weight = static_cast<double>(overlap) / width_;
+            auto& b = profile_.bins[bin];
+            b.mean_ops += num_ops_ * weight;
+            b.max_ops = std::max(b.max_ops, num_ops_);
+            b.mean_procs += procs_.size() * weight;
+            b.max_procs = std::max<std::uint64_t>(b.max_procs, procs_.size());
+            b.mean_files += files_.size() * weight;
+            b.max_files = std::max<std::uint64_t>(b.max_files, files_.size());
+            b.bytes += rate_ * overlap;
+            pos += overlap;
+        }
+    }
+
+    void add_instant(const instant& inst)
+    {
+        profile_.bins[static_cast<std::size_t>((inst.time - start_) / width_)].bytes += inst.bytes;
+    }
+
+private:
+    template<typename Key>
+    static void release(std::unordered_map<Key, std::uint64_t>& active, Key key)
+    {
+        auto it = active.find(key);
+        if (--it->second == 0) {
+            active.erase(it);
+        }
+    }
+
+    concurrency_profile& profile_;
+    rep start_;
+    rep width_;
+    std::uint64_t num_ops_ = 0;
+    std::unordered_map<std::uint64_t, std::uint64_t> procs_;
+    std::unordered_map<std::uint32_t, std::uint64_t> files_;
+    double rate_ = 0.0;
+};
+
+void sweep(const std::vector<span_event>& events, const std::vector<instant>& instants,
+        concurrency_profile& profile)
+{
+    sweep_state state(profile);
+    auto it = events.begin();
+    while (it != events.end())
+    {
+        const auto time = it->time;
+        for (; it != events.end() && it->time == time; ++it)
+        {
+            state.apply(*it);
+        }
+        if (it != events.end()) {
+            state.advance(time, it->time);
+        }
+    }
+    for (const auto& inst : instants)
+    {
+        state.add_instant(inst);
+    }
+}
+
+} // namespace
+
+double concurrency_profile::bandwidth(std::size_t bin) const
+{
+    const auto secs = std::chrono::duration<double>(bin_width).count();
+    return secs > 0.0 ? bins[bin].bytes / secs : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const concurrency_profile& profile)
+{
+    const auto flags = os.flags();
+    const auto fs = profile.file_system.empty() ? std::string("all") : profile.file_system;
+    const auto start = std::chrono::duration_cast<otf2::chrono::microseconds>(
+            profile.start.time_since_epoch()).count();
+    const auto width = std::chrono::duration_cast<otf2::chrono::microseconds>(profile.bin_width).count();
+    os << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < profile.bins.size(); ++i)
+    {
+        const auto& bin = profile.bins[i];
+        os << fs << "," << start + static_cast<decltype(start)>(i) * width
+            << "," << bin.mean_ops << "," << bin.max_ops
+            << "," << bin.mean_procs << "," << bin.max_procs
+            << "," << bin.mean_files << "," << bin.max_files
+            << "," << profile.bandwidth(i) << "\n";
+    }
+    os.flags(flags);
+    return os;
+}
+
+std::vector<concurrency_profile> concurrency_over_time(const IoGraph& graph,
+        otf2::chrono::duration bin_width)
+{
+    if (bin_width.count() <= 0) {
+        throw std::invalid_argument("bin width must be positive");
+    }
+
+    const auto& file_to_fs = graph.graph_properties().file_to_fs;
+    std::vector<concurrency_profile> profiles(1);
+    std::map<std::string, std::uint32_t> fs_index;
+    for (const auto& kvp : file_to_fs)
+    {
+        fs_index.emplace(kvp.second, 0);
+    }
+    for (auto& kvp : fs_index)
+    {
+        kvp.second = static_cast<std::uint32_t>(profiles.size());
+        profiles.emplace_back();
+        profiles.back().file_system = kvp.first;
+    }
+
+    std::unordered_map<std::string, std::uint32_t> file_ids;
+    std::vector<std::uint32_t> file_fs;
+    std::vector<span_event> events;
+    std::vector<instant> instants;
+    auto first = otf2::chrono::armageddon();
+    auto last = otf2::chrono::genesis();
+    const auto vip = graph.vertices();
+    for (auto vit = vip.first; vit != vip.second; ++vit)
+    {
+        const auto& vertex = graph[*vit];
+        if (vertex.type != vertex_kind::io_event
+                || vertex.duration.enter == otf2::chrono::armageddon()
+                || vertex.duration.leave == otf2::chrono::armageddon()) {
+            continue;
+        }
+        const auto& io = boost::get<io_event_property>(vertex.property);
+        auto file = file_ids.find(io.filename);
+        if (file == file_ids.end())
+        {
+            const auto fs = file_to_fs.find(io.filename);
+            file_fs.push_back(fs != file_to_fs.end() ? fs_index[fs->second] : 0);
+            file = file_ids.emplace(io.filename, static_cast<std::uint32_t>(file_fs.size() - 1)).first;
+        }
+        const auto fs = file_fs[file->second];
+        const auto enter = vertex.duration.enter.time_since_epoch().count();
+        const auto leave = vertex.duration.leave.time_since_epoch().count();
+        const double bytes = is_data_access(io) ? io.response_size : 0;
+        first = std::min(first, vertex.duration.enter);
+        last = std::max(last, vertex.duration.leave);
+        if (leave <= enter)
+        {
+            instants.push_back(instant { enter, fs, bytes });
+            continue;
+        }
+        const auto rate = bytes / (leave - enter);
+        events.push_back(span_event { enter, io.proc_id, file->second, fs, rate, true });
+        events.push_back(span_event { leave, io.proc_id, file->second, fs, -rate, false });
+    }
+
+    if (first > last) {
+        return profiles;
+    }
+    const auto num_bins = static_cast<std::size_t>((last - first) / bin_width) + 1;
+    for (auto& profile : profiles)
+    {
+        profile.start = first;
+        profile.bin_width = bin_width;
+        profile.bins.resize(num_bins);
+    }
+
+    parallel_sort(events.begin(), events.end(),
+            [](const span_event& a, const span_event& b) { return a.time < b.time; });
+    sweep(events, instants, profiles[0]);
+
+    // the events of each file system keep the global order
+    std::vector<std::vector<span_event>> fs_events(profiles.size());
+    std::vector<std::vector<instant>> fs_instants(profiles.size());
+    for (const auto& evt : events)
+    {
+        if (evt.fs != 0) {
+            fs_events[evt.fs].push_back(evt);
+        }
+    }
+    for (const auto& inst : instants)
+    {
+        if (inst.fs != 0) {
+            fs_instants[inst.fs].push_back(inst);
+        }
+    }
+    for (std::size_t i = 1; i < profiles.size(); ++i)
+    {
+        sweep(fs_events[i], fs_instants[i], profiles[i]);
+    }
+    return profiles;
+}
+
+}} // namespace rabbitxx::analysis
@@ -0,0 +1,95 @@
+#include <rabbitxx/csv.hpp>
+#include <rabbitxx/log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+
+namespace rabbitxx
+{
+
+double calculate_bandwidth(const io_event_property& io_evt)
+{
+    if (std::numeric_limits<std::uint64_t>::max() == io_evt.response_size) {
+        logging::debug() << "Warn, response size is int MAX return 0.0";
+        return 0.0;
+    }
+
+    // throw an exception if my duration is less than zero
+    auto dur_in_sec = std::chrono::duration_cast<FpSeconds>(*io_evt.iop_duration);
+    // can we convert the unit in a type-safe manner?
+    auto mb_rs = (io_evt.response_size / 1024.) / 1024.;
+    double bw = mb_rs / dur_in_sec.count();
+
+    return bw;
+}
+
+void csv_header(std::ostream& os)
+{
+    std::array<const char*, 12> columns {
+        "pid,",
+        "filename,",
+        "region_name,",
+        "paradigm,",
+        "request_size,",
+        "response_size,",
+        "offset,",
+        "option,",
+        "kind,",
+        "duration,",
+        "bandwidth(MB/s),",
+        "timestamp"};
+    std::copy(columns.begin(), columns.end(), std::ostream_iterator<const char*>(os, ""));
+    os << "\n";
+}
+
+std::string get_option(const io_event_property& io_evt)
+{
+    switch (io_evt.kind)
+    {
+        case io_event_kind::seek:
+            return to_string(
+                    boost::get<otf2::common::io_seek_option_type>(io_evt.option));
+        default:
+            return "None";
+    }
+}
+
+std::ostream& io_event_2_csv_stream(const IoGraph& graph, const VertexDescriptor& evt, std::ostream& out)
+{
+    const auto& io_evt = get_io_property(graph, evt);
+    out << io_evt.proc_id << ", "
+        << io_evt.filename << ", "
+        << io_evt.region_name << ", "
+        << io_evt.paradigm << ", "
+        << io_evt.request_size << ", "
+        << io_evt.response_size << ", "
+        << io_evt.offset << ", "
+        << get_option(io_evt) << ", "
+        << io_evt.kind << ", "
+        << std::chrono::duration_cast<FpMicroseconds>(graph[evt].duration.duration).count() << ", ";
+
+    if (io_evt.iop_duration) {
+        auto bw_mbs = calculate_bandwidth(io_evt);
+        out << bw_mbs << ", ";
+    }
+    else {
+        out << "None, ";
+    }
+    out << io_evt.timestamp;
+
+    return out;
+}
+
+void set2csv(const IoGraph& graph, const set_t<VertexDescriptor>& set, std::ostream& out)
+{
+    csv_header(out);
+    for (auto evt : set)
+    {
+        io_event_2_csv_stream(graph, evt, out);
+        out << "\n";
+    }
+}
+
+} // namespace rabbitxx
@@ -24,12 +24,14 @@ Experiment_Stats Experiment::run(output_func out_f=experiment_output)
 {
     // create dir structure
     create_directory_structure(experiment_dir_, config_);
+    profiler::global().reset();
     const auto experiment_start_ts = std::chrono::system_clock::now();
     experiment_results res;
     auto experiment_stats = run_experiment(res);
     const auto experiment_end_ts = std::chrono::system_clock::now();
     auto experiment_dur = experiment_end_ts - experiment_start_ts;
     experiment_stats.set_experiment_duration(experiment_dur);
+    experiment_stats.set_profile(profiler::global().result());
     out_f(res, experiment_stats, config_, experiment_dir_);
     return experiment_stats;
 }
@@ -53,31 +55,47 @@ Experiment_Stats Experiment::run_experiment(experiment_results& results)
 {
     // graph construction
     const auto start_graph_construction = std::chrono::system_clock::now();
-    auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(trace_file_.string());
+    auto graph = [this] {
+        profile_scope scope("graph construction");
+        return make_graph<graph::OTF2_Io_Graph_Builder>(trace_file_.string(), config_.builder);
+    }();
     const auto end_graph_construction = std::chrono::system_clock::now();
     const auto graph_duration = end_graph_construction - start_graph_construction;
     auto graph_stats = Graph_Stats(graph, graph_duration);
-    auto info = graph.graph_properties();
+    const auto& info = graph.graph_properties();
 
     if (config_.pio_sets || config_.cio_sets)
     {
         // measure cio sets per process
         const auto start_set_per_proc = std::chrono::system_clock::now();
-        auto sets_pp = cio_sets_per_process(graph);
+        auto sets_pp = [this, &graph] {
+            profile_scope scope("pio sets");
+            auto sets = cio_sets_per_process(graph);
+            if (!config_.layer.empty()) {
+                restrict_to_layer(graph, sets, config_.layer);
+            }
+            return sets;
+        }();
         const auto end_set_per_proc = std::chrono::system_clock::now();
         const auto duration = end_set_per_proc - start_set_per_proc;
         auto pio_stats = PIO_Stats(graph, sets_pp, duration);
 
         const auto start_set_merge = std::chrono::system_clock::now();
-        auto cio_sets = find_cio_sets(graph, sets_pp);
+        auto cio_sets = [&graph, &sets_pp] {
+            profile_scope scope("cio sets");
+            return find_cio_sets(graph, sets_pp);
+        }();
         const auto end_set_merge = std::chrono::system_clock::now();
         const auto cio_duration = end_set_merge - start_set_merge;
         auto cio_stats = CIO_Stats(graph, cio_sets, cio_duration);
 
+        // `info` refers into the graph, use it before the graph is moved
+        auto stats = Experiment_Stats(trace_file_, graph_stats, cio_stats, pio_stats, info.file_to_fs, info.clock_props, info.num_locations);
+        stats.set_ingestion(info.ingestion);
         results.graph = std::move(graph);
         results.cio_sets = std::move(cio_sets);
         results.pio_sets = std::move(sets_pp);
-        return Experiment_Stats(trace_file_, graph_stats, cio_stats, pio_stats, info.file_to_fs, info.clock_props, info.num_locations);
+        return stats;
     }
 
 }
@@ -0,0 +1,176 @@
+#include <rabbitxx/analysis/false_sharing.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+struct unit_range
+{
+    std::uint64_t first;
+    std::uint64_t last;
+    std::uint64_t proc_id;
+    bool write;
+};
+
+struct boundary
+{
+    std::uint64_t pos;
+    std::uint64_t proc_id;
+    bool write;
+    bool start;
+
+    bool operator<(const boundary& other) const noexcept
+    {
+        return pos < other.pos;
+    }
+};
+
+void sweep(std::vector<unit_range>& ranges, file_sharing& res)
+{
+    std::vector<boundary> bounds;
+    bounds.reserve(2 * ranges.size());
+    std::set<std::uint64_t> procs;
+    for (const auto& range : ranges)
+    {
+        bounds.push_back(boundary { range.first, range.proc_id, range.write, true });
+        bounds.push_back(boundary { range.last + 1, range.proc_id, range.write, false });
+        procs.insert(range.proc_id);
+    }
+    res.num_procs = procs.size();
+    std::sort(bounds.begin(), bounds.end());
+
+    const auto stripe_count = std::max<std::uint64_t>(res.layout.stripe_count, 1);
+    std::vector<bool> contended(stripe_count, false);
+    // number of active accesses per process
+    std::unordered_map<std::uint64_t, std::uint64_t> active;
+    std::uint64_t num_accesses = 0;
+    std::uint64_t num_writes = 0;
+
+    auto it = bounds.begin();
+    while (it != bounds.end())
+    {
+        const auto pos = it->pos;
+        for (; it != bounds.end() && it->pos == pos; ++it)
+        {
+            if (it->start) {
+                ++active[it->proc_id];
+                ++num_accesses;
+                num_writes += it->write;
+                continue;
+            }
+            auto proc = active.find(it->proc_id);
+            if (--proc->second == 0) {
+                active.erase(proc);
+            }
+            --num_accesses;
+            num_writes -= it->write;
+        }
+        if (it == bounds.end() || num_accesses == 0) {
+            continue;
+        }
+
+        // units [pos, next) are touched by the same accesses
+        const auto len = it->pos - pos;
+        const auto sharers = active.size();
+        res.units_touched += len;
+        res.max_sharers = std::max<std::uint64_t>(res.max_sharers, sharers);
+        if (sharers < 2) {
+            continue;
+        }
+        res.shared_units += len;
+        if (num_writes == 0) {
+            continue;
+        }
+        res.conflicting_units += len;
+        res.min_lock_transfers += len * (sharers - 1);
+        res.max_lock_transfers += len * (num_accesses - 1);
+        if (len >= stripe_count) {
+            std::fill(contended.begin(), contended.end(), true);
+        }
+        else {
+            for (auto unit = pos; unit != it->pos; ++unit)
+            {
+                contended[unit % stripe_count] = true;
+            }
+        }
+    }
+    res.contended_servers = std::count(contended.begin(), contended.end(), true);
+}
+
+} // namespace
+
+stripe_config default_stripe_config()
+{
+    stripe_config config;
+    config.default_layout = fs_layout { 4096, 1 };
+    config.per_fs["lustre"] = fs_layout { 1024 * 1024, 1 };
+    config.per_fs["gpfs"] = fs_layout { 4 * 1024 * 1024, 1 };
+    return config;
+}
+
+std::ostream& operator<<(std::ostream& os, const file_sharing& sharing)
+{
+    return os << "file: " << sharing.filename
+        << " fs: " << sharing.file_system
+        << " block size: " << sharing.layout.block_size
+        << " stripe count: " << sharing.layout.stripe_count
+        << " processes: " << sharing.num_procs
+        << " units: " << sharing.units_touched
+        << " shared: " << sharing.shared_units
+        << " conflicting: " << sharing.conflicting_units
+        << " max sharers: " << sharing.max_sharers
+        << " contended servers: " << sharing.contended_servers
+        << " lock transfers: [" << sharing.min_lock_transfers
+        << ", " << sharing.max_lock_transfers << "]";
+}
+
+std::vector<file_sharing> analyze_false_sharing(const IoGraph& graph,
+        const set_t<VertexDescriptor>& cio_set,
+        const stripe_config& config)
+{
+    const auto& file_to_fs = graph.graph_properties().file_to_fs;
+    std::map<std::string, std::pair<file_sharing, std::vector<unit_range>>> files;
+    for (const auto vd : cio_set)
+    {
+        const auto& io = boost::get<io_event_property>(graph[vd].property);
+        if (!is_data_access(io) || io.response_size == 0) {
+            continue;
+        }
+        auto it = files.find(io.filename);
+        if (it == files.end())
+        {
+            file_sharing sharing;
+            sharing.filename = io.filename;
+            const auto fs = file_to_fs.find(io.filename);
+            if (fs != file_to_fs.end()) {
+                sharing.file_system = fs->second;
+            }
+            sharing.layout = config.layout(sharing.file_system);
+            it = files.emplace(io.filename, std::make_pair(sharing, std::vector<unit_range>())).first;
+        }
+        const auto block_size = std::max<std::uint64_t>(it->second.first.layout.block_size, 1);
+        const auto write = io.kind == io_event_kind::write;
+        auto& ranges = it->second.second;
+        if (io.response_size > 0) {
+            const auto begin = begin_offset(io);
+            ranges.push_back(unit_range { begin / block_size,
+                    (begin + io.response_size - 1) / block_size, io.proc_id, write });
+        }
+    }
+
+    std::vector<file_sharing> result;
+    result.reserve(files.size());
+    for (auto& kvp : files)
+    {
+        sweep(kvp.second.second, kvp.second.first);
+        result.push_back(std::move(kvp.second.first));
+    }
+    return result;
+}
+
+}} // namespace rabbitxx::analysis
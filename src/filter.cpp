@@ -0,0 +1,115 @@
+#include <rabbitxx/filter.hpp>
+
+#include <iterator>
+
+namespace rabbitxx
+{
+
+path_trie::path_trie() : nodes_(1)
+{
+}
+
+void
+path_trie::insert(const std::string& prefix)
+{
+    std::size_t cur = 0;
+    for (const char c : prefix)
+    {
+        const auto it = nodes_[cur].children.find(c);
+        if (it != nodes_[cur].children.end())
+        {
+            cur = it->second;
+            continue;
+        }
+        nodes_.emplace_back();
+        const auto next = nodes_.size() - 1;
+        nodes_[cur].children.emplace(c, next);
+        cur = next;
+    }
+    if (!nodes_[cur].terminal)
+    {
+        nodes_[cur].terminal = true;
+        ++num_prefixes_;
+    }
+}
+
+bool
+path_trie::matches_prefix(const std::string& path) const
+{
+    std::size_t cur = 0;
+    if (nodes_[cur].terminal)
+    {
+        return true;
+    }
+    for (const char c : path)
+    {
+        const auto it = nodes_[cur].children.find(c);
+        if (it == nodes_[cur].children.end())
+        {
+            return false;
+        }
+        cur = it->second;
+        if (nodes_[cur].terminal)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+filter_spec
+filter_spec::pseudo_files()
+{
+    filter_spec spec;
+    for (const auto& prefix : { "/proc", "/sys", "/dev", "/cgroup", "/etc", "/run", "/sw",
+             "/software", "stdout", "STDOUT_FILENO" })
+    {
+        spec.excluded_paths.insert(prefix);
+    }
+    return spec;
+}
+
+bool
+filter_spec::is_paradigm_filtered(const std::string& paradigm) const
+{
+    if (!allowed_paradigms.empty() && allowed_paradigms.count(paradigm) == 0)
+    {
+        return true;
+    }
+    return excluded_paradigms.count(paradigm) > 0;
+}
+
+bool
+filter_spec::is_path_filtered(const std::string& path) const
+{
+    return excluded_paths.matches_prefix(path);
+}
+
+bool
+filter_spec::is_region_filtered(const std::string& region) const
+{
+    if (!included_regions.empty() && included_regions.count(region) == 0)
+    {
+        return true;
+    }
+    return excluded_regions.count(region) > 0;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const filter_spec& spec)
+{
+    auto print_set = [&os](const char* name, const std::set<std::string>& s) {
+        os << name << ": [ ";
+        std::copy(s.begin(), s.end(), std::ostream_iterator<std::string>(os, " "));
+        os << "] ";
+    };
+
+    os << "excluded path prefixes: " << spec.excluded_paths.size() << " ";
+    print_set("allowed paradigms", spec.allowed_paradigms);
+    print_set("excluded paradigms", spec.excluded_paradigms);
+    print_set("included regions", spec.included_regions);
+    print_set("excluded regions", spec.excluded_regions);
+    return os;
+}
+
+} // namespace rabbitxx
@@ -0,0 +1,320 @@
+#include <rabbitxx/graph/builder/graph_size_estimate.hpp>
+#include <rabbitxx/graph/builder/otf2_io_graph_builder.hpp>
+#include <rabbitxx/graph/io_graph.hpp>
+#include <rabbitxx/log.hpp>
+
+namespace rabbitxx { namespace graph {
+
+namespace
+{
+    // average number of out-edges of a vertex, most vertices have exactly one
+    // successor, synchronization events have one per involved process
+    constexpr std::uint64_t avg_out_edges = 2;
+    // size of an out-edge without edge properties
+    constexpr std::uint64_t edge_size = 2 * sizeof(void*);
+    // heap memory of the string properties, e.g. filename and region name
+    constexpr std::uint64_t avg_string_heap = 64;
+
+    constexpr std::uint64_t vertex_size = sizeof(IoGraph::impl_type::stored_vertex);
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const presize_mode mode)
+{
+    switch (mode)
+    {
+        case presize_mode::none:
+            os << "none";
+            break;
+        case presize_mode::definitions:
+            os << "definitions";
+            break;
+        case presize_mode::count:
+            os << "count";
+            break;
+    }
+    return os;
+}
+
+std::uint64_t graph_size_estimate::num_events() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (const auto& kvp : locations)
+    {
+        sum += kvp.second.num_events;
+    }
+    return sum;
+}
+
+std::uint64_t graph_size_estimate::num_io_vertices() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (const auto& kvp : locations)
+    {
+        sum += kvp.second.io_vertices;
+    }
+    return sum;
+}
+
+std::uint64_t graph_size_estimate::num_sync_vertices() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (const auto& kvp : locations)
+    {
+        sum += kvp.second.sync_vertices;
+    }
+    return sum;
+}
+
+std::uint64_t graph_size_estimate::num_vertices() const noexcept
+{
+    // synthetic root and end vertex
+    return num_io_vertices() + num_sync_vertices() + 2;
+}
+
+std::uint64_t graph_size_estimate::vertex_bytes() noexcept
+{
+    return vertex_size + avg_out_edges * edge_size + avg_string_heap;
+}
+
+std::uint64_t graph_size_estimate::memory_bytes() const noexcept
+{
+    return num_vertices() * vertex_bytes();
+}
+
+std::ostream& operator<<(std::ostream& os, const graph_size_estimate& est)
+{
+    os << "[mode: " << est.mode << "] "
+        << "[locations: " << est.locations.size() << "] "
+        << "[events: " << est.num_events() << "] "
+        << "[I/O vertices: " << est.num_io_vertices() << "] "
+        << "[sync vertices: " << est.num_sync_vertices() << "] "
+        << "[memory: " << est.memory_bytes() / (1024 * 1024) << " MiB]";
+    return os;
+}
+
+graph_size_estimate estimate_from_definitions(const otf2::reader::reader& rdr)
+{
+    graph_size_estimate est;
+    est.mode = presize_mode::definitions;
+    for (const auto& location : rdr.locations())
+    {
+        auto& loc_est = est.locations[location.ref()];
+        loc_est.num_events = location.num_events();
+        loc_est.io_vertices = loc_est.num_events / 3;
+    }
+    return est;
+}
+
+void event_counter::definitions_done(const otf2::reader::reader& rdr)
+{
+    estimate_.mode = presize_mode::count;
+    for (const auto& location : rdr.locations())
+    {
+        // the events of unselected locations are not read at all
+        if (config_ != nullptr && !config_->locations.empty()
+                && config_->locations.count(location.ref()) == 0) {
+            continue;
+        }
+        estimate_.locations[location.ref()] = location_estimate();
+        rdr.register_location(location);
+    }
+
+    if (config_ == nullptr) {
+        return;
+    }
+    const auto& filter = config_->filter;
+    for (const auto& handle : rdr.io_handles())
+    {
+        // same name resolution as `io_graph_builder::get_handle_name`
+        const auto name = handle.name().str().empty() ? handle.file().name().str()
+                                                        : handle.name().str();
+        if ((!config_->keep_all_layers && filter.is_paradigm_filtered(handle.paradigm().name().str()))
+                || filter.is_path_filtered(name))
+        {
+            const typename otf2::reference<otf2::definition::io_handle>::ref_type idx = handle.ref();
+            if (filtered_handles_.size() <= idx) {
+                filtered_handles_.resize(idx + 1, false);
+            }
+            filtered_handles_[idx] = true;
+        }
+    }
+}
+
+bool event_counter::in_window(otf2::chrono::time_point tp) const
+{
+    return config_ == nullptr || (config_->window_begin <= tp && tp <= config_->window_end);
+}
+
+bool event_counter::is_filtered(const otf2::definition::io_handle& handle) const
+{
+    const typename otf2::reference<otf2::definition::io_handle>::ref_type idx = handle.ref();
+    return idx < filtered_handles_.size() && filtered_handles_[idx];
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::enter&)
+{
+    ++at(location).num_events;
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::leave&)
+{
+    ++at(location).num_events;
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_operation_complete& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp()) && !is_filtered(evt.handle())) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_create_handle& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp()) && !is_filtered(evt.handle())) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_delete_file& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())
+            && (config_ == nullptr || !config_->filter.is_path_filtered(evt.file().name().str()))) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_destroy_handle& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp()) && !is_filtered(evt.handle())) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_duplicate_handle& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp()) && !is_filtered(evt.new_handle())) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::io_seek& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp()) && !is_filtered(evt.handle())) {
+        ++loc_est.io_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::mpi_collective_end& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())) {
+        ++loc_est.sync_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::mpi_ireceive& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())) {
+        ++loc_est.sync_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::mpi_isend& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())) {
+        ++loc_est.sync_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::mpi_receive& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())) {
+        ++loc_est.sync_vertices;
+    }
+}
+
+void event_counter::event(const otf2::definition::location& location,
+                            const otf2::event::mpi_send& evt)
+{
+    auto& loc_est = at(location);
+    ++loc_est.num_events;
+    if (in_window(evt.timestamp())) {
+        ++loc_est.sync_vertices;
+    }
+}
+
+namespace
+{
+
+graph_size_estimate estimate_graph_size(const std::string& trace_file, presize_mode mode,
+                                        event_counter& counter)
+{
+    if (mode == presize_mode::none)
+    {
+        return graph_size_estimate();
+    }
+    otf2::reader::reader trc_reader(trace_file);
+    trc_reader.set_callback(counter);
+    trc_reader.read_definitions();
+    if (mode == presize_mode::definitions)
+    {
+        return estimate_from_definitions(trc_reader);
+    }
+    trc_reader.read_events();
+    return counter.estimate();
+}
+
+} // namespace
+
+graph_size_estimate estimate_graph_size(const std::string& trace_file, presize_mode mode)
+{
+    event_counter counter;
+    return estimate_graph_size(trace_file, mode, counter);
+}
+
+graph_size_estimate estimate_graph_size(const std::string& trace_file, const builder_config& config)
+{
+    event_counter counter(config);
+    auto est = estimate_graph_size(trace_file, config.presize, counter);
+    if (!config.locations.empty())
+    {
+        for (auto it = est.locations.begin(); it != est.locations.end();)
+        {
+            it = config.locations.count(it->first) > 0 ? std::next(it) : est.locations.erase(it);
+        }
+    }
+    return est;
+}
+
+}} // namespace rabbitxx::graph
@@ -0,0 +1,174 @@
+#include <rabbitxx/analysis/imbalance.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <map>
+#include <thread>
+
+namespace rabbitxx { namespace analysis {
+
+std::ostream& operator<<(std::ostream& os, const set_imbalance& imbalance)
+{
+    os << "processes: " << imbalance.procs.size()
+        << " max/mean: " << imbalance.max_over_mean
+        << " cv: " << imbalance.coefficient_of_variation
+        << " straggler wait: " << imbalance.straggler_wait.count()
+        << " end sync: " << imbalance.end_sync_time.count()
+        << " (straggler: " << imbalance.end_sync_straggler_time.count() << ")"
+        << " slowest processes:";
+    for (const auto proc : imbalance.slowest_procs)
+    {
+        os << " " << proc;
+    }
+    os << " slowest files:";
+    for (const auto& file : imbalance.slowest_files)
+    {
+        os << " " << file;
+    }
+    return os;
+}
+
+set_imbalance analyze_imbalance(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set,
+        std::size_t top_n)
+{
+    std::map<std::uint64_t, process_load> procs;
+    std::map<std::string, file_load> files;
+    for (const auto vd : cio_set)
+    {
+        const auto& vertex = graph[vd];
+        const auto& io = boost::get<io_event_property>(vertex.property);
+        const auto time = operation_time(vertex);
+
+        auto& proc = procs[io.proc_id];
+        proc.proc_id = io.proc_id;
+        proc.io_time += time;
+        proc.bytes += io.response_size;
+        ++proc.num_ops;
+        // the timestamp of an I/O vertex is its completion
+        proc.io_end = std::max(proc.io_end, io.timestamp);
+
+        auto& file = files[io.filename];
+        file.filename = io.filename;
+        file.io_time += time;
+        file.bytes += io.response_size;
+        ++file.num_ops;
+    }
+
+    set_imbalance res;
+    if (procs.empty()) {
+        return res;
+    }
+
+    auto last_end = otf2::chrono::genesis();
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double max = 0.0;
+    for (const auto& kvp : procs)
+    {
+        const auto time = static_cast<double>(kvp.second.io_time.count());
+        sum += time;
+        sum_sq += time * time;
+        max = std::max(max, time);
+        last_end = std::max(last_end, kvp.second.io_end);
+    }
+    const auto mean = sum / procs.size();
+    if (mean > 0.0)
+    {
+        res.max_over_mean = max / mean;
+        res.coefficient_of_variation = std::sqrt(std::max(0.0, sum_sq / procs.size() - mean * mean)) / mean;
+    }
+
+    res.procs.reserve(procs.size());
+    for (auto& kvp : procs)
+    {
+        kvp.second.straggler_wait = last_end - kvp.second.io_end;
+        res.straggler_wait += kvp.second.straggler_wait;
+        res.procs.push_back(kvp.second);
+    }
+
+    std::vector<const process_load*> by_time;
+    by_time.reserve(res.procs.size());
+    for (const auto& proc : res.procs)
+    {
+        by_time.push_back(&proc);
+    }
+    const auto num_slowest = std::min(top_n, by_time.size());
+    std::partial_sort(by_time.begin(), by_time.begin() + num_slowest, by_time.end(),
+            [](const process_load* a, const process_load* b) { return a->io_time > b->io_time; });
+    for (std::size_t i = 0; i < num_slowest; ++i)
+    {
+        res.slowest_procs.push_back(by_time[i]->proc_id);
+    }
+
+    res.files.reserve(files.size());
+    for (auto& kvp : files)
+    {
+        res.files.push_back(std::move(kvp.second));
+    }
+    std::stable_sort(res.files.begin(), res.files.end(),
+            [](const file_load& a, const file_load& b) { return a.io_time > b.io_time; });
+    for (std::size_t i = 0; i < std::min(top_n, res.files.size()); ++i)
+    {
+        res.slowest_files.push_back(res.files[i].filename);
+    }
+
+    const auto end_event = cio_set.end_event();
+    if (!end_event || graph[*end_event].type != vertex_kind::sync_event) {
+        return res;
+    }
+    // the end event is the root of the closing synchronization, which is
+    // linked to the synchronization vertices of the other processes
+    std::vector<VertexDescriptor> closing { *end_event };
+    const auto adjacent = boost::adjacent_vertices(*end_event, *graph.get());
+    for (auto it = adjacent.first; it != adjacent.second; ++it)
+    {
+        if (graph[*it].type == vertex_kind::sync_event
+                && boost::get<sync_event_property>(graph[*it].property).root_event == *end_event) {
+            closing.push_back(*it);
+        }
+    }
+    for (const auto vd : closing)
+    {
+        const auto& sync = boost::get<sync_event_property>(graph[vd].property);
+        const auto proc = procs.find(sync.proc_id);
+        if (proc == procs.end()) {
+            continue;
+        }
+        const auto time = graph[vd].duration.duration;
+        res.end_sync_time += time;
+        res.end_sync_straggler_time += std::min(time, proc->second.straggler_wait);
+    }
+    return res;
+}
+
+std::vector<set_imbalance> analyze_imbalance(const IoGraph& graph,
+        const set_container_t<VertexDescriptor>& cio_sets,
+        std::size_t top_n)
+{
+    std::vector<set_imbalance> result(cio_sets.size());
+    const auto num_workers = std::min<std::size_t>(cio_sets.size(),
+            std::max(1u, std::thread::hardware_concurrency()));
+    // the graph is only read, each worker takes the next unprocessed set
+    std::atomic<std::size_t> next {0};
+    std::vector<std::future<void>> workers;
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            for (auto idx = next++; idx < cio_sets.size(); idx = next++)
+            {
+                result[idx] = analyze_imbalance(graph, cio_sets[idx], top_n);
+            }
+        }));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+    return result;
+}
+
+}} // namespace rabbitxx::analysis
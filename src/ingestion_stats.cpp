@@ -0,0 +1,152 @@
+#include <rabbitxx/graph/ingestion_stats.hpp>
+#include <rabbitxx/log.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+namespace rabbitxx { namespace graph {
+
+const char* to_string(callback_type type)
+{
+    switch (type)
+    {
+        case callback_type::enter: return "enter";
+        case callback_type::leave: return "leave";
+        case callback_type::io_operation_begin: return "io_operation_begin";
+        case callback_type::io_operation_complete: return "io_operation_complete";
+        case callback_type::io_operation_issued: return "io_operation_issued";
+        case callback_type::io_operation_test: return "io_operation_test";
+        case callback_type::io_operation_cancelled: return "io_operation_cancelled";
+        case callback_type::io_acquire_lock: return "io_acquire_lock";
+        case callback_type::io_try_lock: return "io_try_lock";
+        case callback_type::io_release_lock: return "io_release_lock";
+        case callback_type::io_change_status_flag: return "io_change_status_flag";
+        case callback_type::io_create_handle: return "io_create_handle";
+        case callback_type::io_delete_file: return "io_delete_file";
+        case callback_type::io_destroy_handle: return "io_destroy_handle";
+        case callback_type::io_duplicate_handle: return "io_duplicate_handle";
+        case callback_type::io_seek: return "io_seek";
+        case callback_type::mpi_collective_begin: return "mpi_collective_begin";
+        case callback_type::mpi_collective_end: return "mpi_collective_end";
+        case callback_type::mpi_send: return "mpi_send";
+        case callback_type::mpi_isend: return "mpi_isend";
+        case callback_type::mpi_isend_complete: return "mpi_isend_complete";
+        case callback_type::mpi_receive: return "mpi_receive";
+        case callback_type::mpi_ireceive: return "mpi_ireceive";
+        case callback_type::mpi_ireceive_request: return "mpi_ireceive_request";
+        case callback_type::mpi_request_test: return "mpi_request_test";
+        case callback_type::mpi_request_cancelled: return "mpi_request_cancelled";
+        case callback_type::unknown: return "unknown";
+        case callback_type::count: break;
+    }
+    return "invalid";
+}
+
+callback_counts& callback_counts::operator+=(const callback_counts& other)
+{
+    seen += other.seen;
+    filtered += other.filtered;
+    converted += other.converted;
+    bytes += other.bytes;
+    time += other.time;
+    return *this;
+}
+
+callback_counts ingestion_summary::total() const
+{
+    callback_counts sum;
+    for (const auto& counts : per_type)
+    {
+        sum += counts;
+    }
+    return sum;
+}
+
+double ingestion_summary::events_per_second() const
+{
+    const auto secs = std::chrono::duration<double>(elapsed).count();
+    return secs > 0.0 ? total().seen / secs : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const ingestion_summary& summary)
+{
+    const auto flags = os.flags();
+    const auto to_ms = [](std::chrono::nanoseconds ns) {
+        return std::chrono::duration<double, std::milli>(ns).count();
+    };
+    os << std::left << std::setw(24) << "callback" << std::right
+        << std::setw(12) << "seen"
+        << std::setw(12) << "filtered"
+        << std::setw(12) << "converted"
+        << std::setw(16) << "bytes"
+        << std::setw(12) << "time [ms]" << "\n";
+    os << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < summary.per_type.size(); ++i)
+    {
+        const auto& counts = summary.per_type[i];
+        if (counts.seen == 0) {
+            continue;
+        }
+        os << std::left << std::setw(24) << to_string(static_cast<callback_type>(i)) << std::right
+            << std::setw(12) << counts.seen
+            << std::setw(12) << counts.filtered
+            << std::setw(12) << counts.converted
+            << std::setw(16) << counts.bytes
+            << std::setw(12) << to_ms(counts.time) << "\n";
+    }
+    const auto total = summary.total();
+    os << "Events: " << total.seen << " of " << summary.expected_events
+        << " in " << to_ms(summary.elapsed) << " ms ("
+        << std::setprecision(0) << summary.events_per_second() << " events/s)\n";
+    os.flags(flags);
+    return os;
+}
+
+ingestion_summary ingestion_stats::summary() const
+{
+    ingestion_summary sum;
+    for (std::size_t i = 0; i < counters_.size(); ++i)
+    {
+        auto& counts = sum.per_type[i];
+        counts.seen = counters_[i].seen.load(std::memory_order_relaxed);
+        counts.filtered = counters_[i].filtered.load(std::memory_order_relaxed);
+        counts.converted = counters_[i].converted.load(std::memory_order_relaxed);
+        counts.bytes = counters_[i].bytes.load(std::memory_order_relaxed);
+        counts.time = std::chrono::nanoseconds(counters_[i].time_ns.load(std::memory_order_relaxed));
+    }
+    sum.expected_events = expected_events_;
+    if (events_seen() > 0) {
+        sum.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_);
+    }
+    return sum;
+}
+
+void ingestion_stats::report_progress(std::uint64_t seen)
+{
+    const auto now = clock::now();
+    if (now - last_report_ < progress_interval_) {
+        return;
+    }
+    last_report_ = now;
+
+    const auto elapsed = std::chrono::duration<double>(now - start_).count();
+    const auto rate = elapsed > 0.0 ? seen / elapsed : 0.0;
+    std::stringstream msg;
+    msg << "read " << seen << " events";
+    if (expected_events_ > 0)
+    {
+        const auto remaining = expected_events_ > seen ? expected_events_ - seen : 0;
+        msg << " of " << expected_events_
+            << " (" << static_cast<int>(100.0 * seen / expected_events_) << "%)";
+        if (rate > 0.0) {
+            msg << ", " << static_cast<std::uint64_t>(rate) << " events/s"
+                << ", " << static_cast<std::uint64_t>(remaining / rate) << " s remaining";
+        }
+    }
+    else if (rate > 0.0) {
+        msg << ", " << static_cast<std::uint64_t>(rate) << " events/s";
+    }
+    logging::info() << msg.str();
+}
+
+}} // namespace rabbitxx::graph
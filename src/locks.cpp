@@ -0,0 +1,196 @@
+#include <rabbitxx/analysis/locks.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rabbitxx { namespace analysis {
+
+namespace {
+
+/**
+ * Latest release of a lock type on a file, and the latest one of any other
+ * process than the one holding it, to check for contention in constant time.
+ */
+class latest_release
+{
+public:
+    void add(std::uint64_t proc_id, otf2::chrono::time_point released)
+    {
+        if (!first_ || released >= first_released_)
+        {
+            if (first_ && proc_id != first_proc_) {
+                second_released_ = first_released_;
+                second_ = true;
+            }
+            first_proc_ = proc_id;
+            first_released_ = released;
+            first_ = true;
+        }
+        else if (proc_id != first_proc_ && (!second_ || released > second_released_))
+        {
+            second_released_ = released;
+            second_ = true;
+        }
+    }
+
+    // whether another process than `proc_id` released after `tp`
+    bool other_after(std::uint64_t proc_id, otf2::chrono::time_point tp) const
+    {
+        if (first_ && proc_id != first_proc_) {
+            return first_released_ > tp;
+        }
+        return second_ && second_released_ > tp;
+    }
+
+private:
+    bool first_ = false;
+    bool second_ = false;
+    std::uint64_t first_proc_ = 0;
+    otf2::chrono::time_point first_released_;
+    otf2::chrono::time_point second_released_;
+};
+
+void add_lock(lock_contention& contention, const io_lock_interval& lock, bool contended)
+{
+    ++contention.locks;
+    if (lock.type == otf2::common::lock_type::exclusive) {
+        ++contention.exclusive;
+    }
+    else {
+        ++contention.shared;
+    }
+    if (contended) {
+        ++contention.contended;
+    }
+    contention.failed_tries += lock.failed_tries;
+    contention.wait_time += lock.wait_time();
+    contention.max_wait = std::max(contention.max_wait, lock.wait_time());
+    contention.hold_time += lock.hold_time();
+    contention.max_hold = std::max(contention.max_hold, lock.hold_time());
+}
+
+lock_summary summarize(const std::vector<const io_lock_interval*>& locks)
+{
+    std::unordered_map<std::string, std::vector<const io_lock_interval*>> per_file;
+    for (const auto lock : locks)
+    {
+        per_file[lock->filename].push_back(lock);
+    }
+
+    lock_summary res;
+    std::unordered_set<std::uint64_t> procs;
+    for (auto& kvp : per_file)
+    {
+        auto& file_locks = kvp.second;
+        std::sort(file_locks.begin(), file_locks.end(),
+                [](const io_lock_interval* a, const io_lock_interval* b) {
+                    return a->acquired < b->acquired;
+                });
+        file_lock_contention file { kvp.first, lock_contention() };
+        std::unordered_set<std::uint64_t> file_procs;
+        latest_release exclusive;
+        latest_release shared;
+        for (const auto lock : file_locks)
+        {
+            // a lock acquired before was still held by another process when
+            // this one was requested
+            auto contended = exclusive.other_after(lock->proc_id, lock->requested);
+            if (lock->type == otf2::common::lock_type::exclusive)
+            {
+                contended = contended || shared.other_after(lock->proc_id, lock->requested);
+                exclusive.add(lock->proc_id, lock->released);
+            }
+            else {
+                shared.add(lock->proc_id, lock->released);
+            }
+            add_lock(file.contention, *lock, contended);
+            add_lock(res.total, *lock, contended);
+            if (contended)
+            {
+                file_procs.insert(lock->proc_id);
+                procs.insert(lock->proc_id);
+            }
+        }
+        file.contention.contenders = file_procs.size();
+        res.files.push_back(std::move(file));
+    }
+    res.total.contenders = procs.size();
+
+    std::sort(res.files.begin(), res.files.end(),
+            [](const file_lock_contention& a, const file_lock_contention& b) {
+                return a.contention.wait_time != b.contention.wait_time
+                    ? a.contention.wait_time > b.contention.wait_time
+                    : a.filename < b.filename;
+            });
+    return res;
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const lock_summary& locks)
+{
+    const auto to_us = [](otf2::chrono::duration dur) {
+        return std::chrono::duration_cast<otf2::chrono::microseconds>(dur).count();
+    };
+    const auto print = [&os, &to_us](const lock_contention& contention) {
+        os << "locks: " << contention.locks
+            << " (exclusive: " << contention.exclusive << " shared: " << contention.shared << ")"
+            << " contended: " << contention.contended
+            << " contenders: " << contention.contenders
+            << " failed tries: " << contention.failed_tries
+            << " wait [us]: " << to_us(contention.wait_time)
+            << " max wait [us]: " << to_us(contention.max_wait)
+            << " hold [us]: " << to_us(contention.hold_time)
+            << " max hold [us]: " << to_us(contention.max_hold);
+    };
+    os << "total ";
+    print(locks.total);
+    os << "\n";
+    for (const auto& file : locks.files)
+    {
+        os << "file " << file.filename << " ";
+        print(file.contention);
+        os << "\n";
+    }
+    return os;
+}
+
+lock_summary analyze_locks(const IoGraph& graph, const set_t<VertexDescriptor>& cio_set)
+{
+    if (cio_set.empty()) {
+        return lock_summary();
+    }
+    auto begin = otf2::chrono::armageddon();
+    auto end = otf2::chrono::genesis();
+    for (const auto vd : cio_set)
+    {
+        const auto& vertex = graph[vd];
+        const auto ts = vertex.timestamp();
+        begin = std::min(begin, ts - operation_time(vertex));
+        end = std::max(end, ts);
+    }
+
+    std::vector<const io_lock_interval*> overlapping;
+    for (const auto& lock : graph.graph_properties().lock_intervals)
+    {
+        if (lock.requested <= end && lock.released >= begin) {
+            overlapping.push_back(&lock);
+        }
+    }
+    return summarize(overlapping);
+}
+
+lock_summary analyze_locks(const std::vector<io_lock_interval>& locks)
+{
+    std::vector<const io_lock_interval*> all;
+    all.reserve(locks.size());
+    for (const auto& lock : locks)
+    {
+        all.push_back(&lock);
+    }
+    return summarize(all);
+}
+
+}} // namespace rabbitxx::analysis
@@ -0,0 +1,234 @@
+#include <rabbitxx/analysis/metadata.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace rabbitxx { namespace analysis {
+
+constexpr directory_trie::node_id directory_trie::root;
+constexpr directory_trie::node_id directory_trie::npos;
+
+namespace {
+
+bool is_metadata(io_event_kind kind) noexcept
+{
+    return kind == io_event_kind::create || kind == io_event_kind::dup
+        || kind == io_event_kind::delete_or_close;
+}
+
+/**
+ * @brief Operations of one directory or prefix within a set.
+ */
+struct metadata_counts
+{
+    directory_metadata result;
+    std::vector<otf2::chrono::duration::rep> times;
+    std::unordered_set<std::uint64_t> procs;
+    std::unordered_set<std::string> files;
+
+    void add(const io_event_property& io, otf2::chrono::duration time)
+    {
+        switch (io.kind)
+        {
+            case io_event_kind::create: ++result.creates; break;
+            case io_event_kind::dup: ++result.dups; break;
+            default: ++result.closes; break;
+        }
+        result.time += time;
+        times.push_back(io.timestamp.time_since_epoch().count());
+        procs.insert(io.proc_id);
+        files.insert(io.filename);
+    }
+
+    void merge(const metadata_counts& other)
+    {
+        result.creates += other.result.creates;
+        result.dups += other.result.dups;
+        result.closes += other.result.closes;
+        result.time += other.result.time;
+        times.insert(times.end(), other.times.begin(), other.times.end());
+        procs.insert(other.procs.begin(), other.procs.end());
+        files.insert(other.files.begin(), other.files.end());
+    }
+
+    directory_metadata finish(const metadata_config& config)
+    {
+        auto& res = result;
+        res.num_procs = procs.size();
+        res.num_files = files.size();
+
+        // two pointers over the sorted timestamps
+        std::sort(times.begin(), times.end());
+        const auto window = config.window.count();
+        std::size_t first = 0;
+        for (std::size_t last = 0; last < times.size(); ++last)
+        {
+            while (first < last && times[last] - times[first] >= window) {
+                ++first;
+            }
+            res.peak_window_ops = std::max<std::uint64_t>(res.peak_window_ops, last - first + 1);
+        }
+
+        const auto window_secs = std::chrono::duration<double>(config.window).count();
+        if (!times.empty() && window_secs > 0.0)
+        {
+            const auto span = otf2::chrono::duration(times.back() - times.front());
+            const auto span_secs = std::max(std::chrono::duration<double>(span).count(), window_secs);
+            res.create_rate = res.creates / span_secs;
+            res.peak_rate = res.peak_window_ops / window_secs;
+        }
+        res.storm = res.peak_rate >= config.storm_rate;
+        return res;
+    }
+};
+
+} // namespace
+
+directory_trie::directory_trie()
+{
+    nodes_.push_back(trie_node { root, 0, "", {} });
+}
+
+directory_trie::node_id directory_trie::insert(const std::string& filename)
+{
+    const auto file = files_.find(filename);
+    if (file != files_.end()) {
+        return file->second;
+    }
+
+    node_id node = root;
+    std::string::size_type begin = 0;
+    // the last component is the file itself
+    for (auto end = filename.find('/'); end != std::string::npos; end = filename.find('/', begin))
+    {
+        if (end > begin)
+        {
+            auto name = filename.substr(begin, end - begin);
+            const auto child = nodes_[node].children.find(name);
+            if (child != nodes_[node].children.end()) {
+                node = child->second;
+            }
+            else
+            {
+                const auto id = static_cast<node_id>(nodes_.size());
+                nodes_[node].children.emplace(name, id);
+                nodes_.push_back(trie_node { node, nodes_[node].depth + 1, std::move(name), {} });
+                node = id;
+            }
+        }
+        begin = end + 1;
+    }
+    files_.emplace(filename, node);
+    return node;
+}
+
+directory_trie::node_id directory_trie::ancestor(node_id node, std::uint32_t depth) const
+{
+    while (nodes_[node].depth > depth) {
+        node = nodes_[node].parent;
+    }
+    return node;
+}
+
+std::string directory_trie::path(node_id node) const
+{
+    if (node == root) {
+        return "/";
+    }
+    std::vector<node_id> components;
+    for (; node != root; node = nodes_[node].parent)
+    {
+        components.push_back(node);
+    }
+    std::string res;
+    for (auto it = components.rbegin(); it != components.rend(); ++it)
+    {
+        res += "/" + nodes_[*it].name;
+    }
+    return res;
+}
+
+directory_trie make_directory_trie(const IoGraph& graph)
+{
+    directory_trie trie;
+    const auto vip = graph.vertices();
+    for (auto vit = vip.first; vit != vip.second; ++vit)
+    {
+        const auto& vertex = graph[*vit];
+        if (vertex.type == vertex_kind::io_event) {
+            trie.insert(boost::get<io_event_property>(vertex.property).filename);
+        }
+    }
+    return trie;
+}
+
+std::ostream& operator<<(std::ostream& os, const directory_metadata& dir)
+{
+    return os << "path: " << dir.path
+        << " creates: " << dir.creates
+        << " dups: " << dir.dups
+        << " closes: " << dir.closes
+        << " processes: " << dir.num_procs
+        << " files: " << dir.num_files
+        << " time: " << dir.time.count()
+        << " create rate: " << dir.create_rate
+        << " peak: " << dir.peak_window_ops << " (" << dir.peak_rate << "/s)"
+        << (dir.storm ? " STORM" : "");
+}
+
+set_metadata analyze_metadata(const IoGraph& graph, const directory_trie& trie,
+        const set_t<VertexDescriptor>& cio_set,
+        const metadata_config& config)
+{
+    if (config.window.count() <= 0) {
+        throw std::invalid_argument("metadata window must be positive");
+    }
+
+    std::unordered_map<directory_trie::node_id, metadata_counts> directories;
+    for (const auto vd : cio_set)
+    {
+        const auto& vertex = graph[vd];
+        const auto& io = boost::get<io_event_property>(vertex.property);
+        if (!is_metadata(io.kind)) {
+            continue;
+        }
+        const auto dir = trie.directory_of(io.filename);
+        if (dir == directory_trie::npos) {
+            continue;
+        }
+        directories[dir].add(io, operation_time(vertex));
+    }
+
+    std::map<std::string, metadata_counts*> by_path;
+    std::unordered_map<directory_trie::node_id, metadata_counts> prefixes;
+    for (auto& kvp : directories)
+    {
+        prefixes[trie.ancestor(kvp.first, config.prefix_depth)].merge(kvp.second);
+        by_path.emplace(trie.path(kvp.first), &kvp.second);
+    }
+
+    set_metadata res;
+    res.directories.reserve(by_path.size());
+    for (auto& kvp : by_path)
+    {
+        kvp.second->result.path = kvp.first;
+        res.directories.push_back(kvp.second->finish(config));
+    }
+    by_path.clear();
+    for (auto& kvp : prefixes)
+    {
+        by_path.emplace(trie.path(kvp.first), &kvp.second);
+    }
+    res.prefixes.reserve(by_path.size());
+    for (auto& kvp : by_path)
+    {
+        kvp.second->result.path = kvp.first;
+        res.prefixes.push_back(kvp.second->finish(config));
+    }
+    return res;
+}
+
+}} // namespace rabbitxx::analysis
@@ -3,12 +3,42 @@
 
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
 
 //#define FILTER_RANK if (mapping_.to_rank(location) != comm().rank()) { return; }
-#define FILTER_RANK if (!is_master()) { return; }
+// account the event in the ingestion counters, must be the first statement of a callback
+#define COUNT_EVENT(type) ingestion_guard<IoGraph> event_guard(ingestion_, callback_type::type, graph_);
+#define FILTER_RANK if (!is_master()) { event_guard.filtered(); return; }
+// skip events outside of the configured time window
+#define FILTER_WINDOW if (!in_window(evt.timestamp())) { event_guard.filtered(); return; }
 
 namespace rabbitxx { namespace graph {
 
+namespace {
+
+bool is_collective(otf2::common::io_operation_flag_type flag)
+{
+    using flag_t = std::underlying_type_t<otf2::common::io_operation_flag_type>;
+    return (static_cast<flag_t>(flag)
+            & static_cast<flag_t>(otf2::common::io_operation_flag_type::collective)) != 0;
+}
+
+io_event_kind to_event_kind(otf2::common::io_operation_mode_type mode)
+{
+    switch (mode)
+    {
+        case otf2::common::io_operation_mode_type::read:
+            return io_event_kind::read;
+        case otf2::common::io_operation_mode_type::write:
+            return io_event_kind::write;
+        case otf2::common::io_operation_mode_type::flush:
+            return io_event_kind::flush;
+    }
+    return io_event_kind::none;
+}
+
+} // namespace
+
 /**
 * @brief Return the mapping object. This is mainly used for debugging.
 */
@@ -33,7 +63,9 @@ io_graph_builder::create_synthetic_root()
         * One possible solution may to get the correct start time from the clock properties.
         * But since this method is called in the constructors initialisation list.
         **/
-    const auto& vt = synthetic_event_property("Root", otf2::chrono::time_point(otf2::chrono::duration(0)));
+    const auto start_tp = has_window() ? config_.window_begin
+                                        : otf2::chrono::time_point(otf2::chrono::duration(0));
+    const auto& vt = synthetic_event_property("Root", start_tp);
     return graph_.add_vertex(otf2_trace_event(vt));
 }
 
@@ -42,11 +74,16 @@ io_graph_builder::create_synthetic_root()
     */
 void io_graph_builder::create_synthetic_end()
 {
-    const auto& vt = synthetic_event_property("End", otf2::chrono::time_point::max());
+    const auto end_tp = has_window() ? config_.window_end : otf2::chrono::time_point::max();
+    const auto& vt = synthetic_event_property("End", end_tp);
     const auto end_descriptor = graph_.add_vertex(otf2_trace_event(vt));
     //get last event from each location
     for (const auto& loc : locations_)
     {
+        if (edge_points_.empty(loc)) {
+            // no events of this location within the window
+            continue;
+        }
         const auto last_proc_event = edge_points_.front(loc);
         graph_.add_edge(last_proc_event, end_descriptor);
     }
@@ -78,9 +115,16 @@ io_graph_builder::build_edge(const VertexDescriptor& descriptor,
 
 void io_graph_builder::set_graph_properties()
 {
-    assert(total_time_ > total_file_io_time_);
-    assert(total_time_ > total_file_io_metadata_time_);
-    assert(max_tp_ > min_tp_);
+    assert(total_time_ >= total_file_io_time_);
+    assert(total_time_ >= total_file_io_metadata_time_);
+    if (min_tp_ > max_tp_)
+    {
+        // no event within the window
+        logging::warn() << "No events within the window [" << config_.window_begin
+                        << ", " << config_.window_end << "]";
+        min_tp_ = config_.window_begin;
+        max_tp_ = config_.window_begin;
+    }
     graph_.get()->operator[](boost::graph_bundle).total_time = total_time_;
     graph_.get()->operator[](boost::graph_bundle).io_time = total_file_io_time_;
     graph_.get()->operator[](boost::graph_bundle).io_metadata_time = total_file_io_metadata_time_;
@@ -90,6 +134,121 @@ void io_graph_builder::set_graph_properties()
     graph_.get()->operator[](boost::graph_bundle).clock_props = clock_props_;
     graph_.get()->operator[](boost::graph_bundle).file_to_fs = file_to_fs_map_;
     graph_.get()->operator[](boost::graph_bundle).num_locations = locations_.size();
+    auto& locs = graph_.get()->operator[](boost::graph_bundle).locations;
+    std::transform(locations_.begin(), locations_.end(), std::back_inserter(locs),
+            [](const otf2::definition::location& loc) -> std::uint64_t { return loc.ref(); });
+    std::sort(locs.begin(), locs.end());
+    graph_.get()->operator[](boost::graph_bundle).ingestion = ingestion_.summary();
+    graph_.get()->operator[](boost::graph_bundle).lock_intervals = lock_intervals_;
+}
+
+void io_graph_builder::reserve(const graph_size_estimate& estimate)
+{
+    graph_size_estimate selected;
+    selected.mode = estimate.mode;
+    for (const auto& kvp : estimate.locations)
+    {
+        if (is_selected(kvp.first)) {
+            selected.locations.insert(kvp);
+        }
+    }
+    logging::info() << "graph size estimate: " << selected;
+    const auto budget = config_.presize_budget_mib * 1024 * 1024 / graph_size_estimate::vertex_bytes();
+    if (selected.num_vertices() > budget) {
+        logging::info() << "reserve just " << budget << " vertices, "
+                        << config_.presize_budget_mib << " MiB presize budget";
+    }
+    graph_.reserve(std::min(selected.num_vertices(), budget));
+}
+
+bool io_graph_builder::has_window() const noexcept
+{
+    return config_.window_begin != otf2::chrono::genesis()
+        || config_.window_end != otf2::chrono::armageddon();
+}
+
+bool io_graph_builder::in_window(otf2::chrono::time_point tp) const noexcept
+{
+    return config_.window_begin <= tp && tp <= config_.window_end;
+}
+
+bool io_graph_builder::is_selected(std::uint64_t location_ref) const
+{
+    return config_.locations.empty() || config_.locations.count(location_ref) > 0;
+}
+
+bool io_graph_builder::is_partial() const noexcept
+{
+    return has_window() || !config_.locations.empty();
+}
+
+void io_graph_builder::remap_process_ids()
+{
+    // dense process id for every selected location, ordered by location reference
+    std::map<std::uint64_t, std::uint64_t> dense_ids;
+    for (const auto& loc : locations_)
+    {
+        dense_ids.emplace(loc.ref(), 0);
+    }
+    std::uint64_t next_id = 0;
+    for (auto& kvp : dense_ids)
+    {
+        kvp.second = next_id++;
+    }
+
+    const auto vertices = graph_.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        auto& vertex = graph_[*it];
+        if (vertex.type == vertex_kind::io_event)
+        {
+            auto& io_evt = boost::get<io_event_property>(vertex.property);
+            io_evt.proc_id = dense_ids.at(io_evt.proc_id);
+        }
+        else if (vertex.type == vertex_kind::sync_event)
+        {
+            auto& sync_evt = boost::get<sync_event_property>(vertex.property);
+            sync_evt.proc_id = dense_ids.at(sync_evt.proc_id);
+            if (sync_evt.comm_kind == sync_event_kind::collective)
+            {
+                const auto coll_op = boost::get<collective>(sync_evt.op_data);
+                auto members = coll_op.members();
+                std::transform(members.begin(), members.end(), members.begin(),
+                        [&dense_ids](std::uint64_t m) { return dense_ids.at(m); });
+                if (coll_op.has_root() && dense_ids.count(coll_op.root()) > 0) {
+                    sync_evt.op_data = collective(dense_ids.at(coll_op.root()), members);
+                }
+                else {
+                    sync_evt.op_data = collective(members);
+                }
+            }
+            else
+            {
+                const auto p2p_op = boost::get<peer2peer>(sync_evt.op_data);
+                const auto remote = dense_ids.at(p2p_op.remote_process());
+                if (p2p_op.request_id()) {
+                    sync_evt.op_data = peer2peer(remote, p2p_op.msg_tag(), p2p_op.msg_length(),
+                                                *p2p_op.request_id());
+                }
+                else {
+                    sync_evt.op_data = peer2peer(remote, p2p_op.msg_tag(), p2p_op.msg_length());
+                }
+            }
+        }
+        else if (vertex.type == vertex_kind::collective_io)
+        {
+            // the processes of a run are all selected, so they stay consecutive
+            auto& call = boost::get<collective_io_property>(vertex.property);
+            for (auto& run : call.ranges.runs)
+            {
+                run.first_proc = dense_ids.at(run.first_proc);
+            }
+        }
+    }
+    for (auto& lock : lock_intervals_)
+    {
+        lock.proc_id = dense_ids.at(lock.proc_id);
+    }
 }
 
 void io_graph_builder::check_time(otf2::chrono::time_point tp)
@@ -101,6 +260,127 @@ void io_graph_builder::check_time(otf2::chrono::time_point tp)
     max_tp_ = max(max_tp_, tp);
 }
 
+bool io_graph_builder::fold_io_operation(const otf2::definition::location& location,
+                                        const io_event_property& io_op,
+                                        std::uint64_t offset_begin)
+{
+    if (edge_points_.empty(location)) {
+        return false;
+    }
+    auto& last_vertex = graph_[edge_points_.front(location)];
+    if (last_vertex.type != vertex_kind::io_event) {
+        return false;
+    }
+    auto& last_op = boost::get<io_event_property>(last_vertex.property);
+    if (!last_op.range || last_op.kind != io_op.kind
+            || last_op.offset != offset_begin
+            || last_op.filename != io_op.filename
+            || last_op.region_name != io_op.region_name
+            || last_op.paradigm != io_op.paradigm) {
+        return false;
+    }
+
+    last_op.request_size += io_op.request_size;
+    last_op.response_size += io_op.response_size;
+    last_op.offset = io_op.offset;
+    last_op.iop_duration = *last_op.iop_duration + *io_op.iop_duration;
+    last_op.timestamp = io_op.timestamp;
+    last_op.range->add(io_op.response_size, *io_op.iop_duration, io_op.timestamp);
+    return true;
+}
+
+bool io_graph_builder::is_filtered(const otf2::definition::location& location,
+                                    const otf2::definition::io_handle& handle)
+{
+    if (is_set(filtered_handles_, handle.ref())) {
+        return true;
+    }
+    return has_region_filter_ && is_region_filtered(location);
+}
+
+bool io_graph_builder::is_filtered(const otf2::definition::location& location,
+                                    const otf2::definition::io_paradigm& paradigm,
+                                    const otf2::definition::io_file& file)
+{
+    if (is_set(filtered_paradigms_, paradigm.ref()) || is_file_filtered(file)) {
+        return true;
+    }
+    return has_region_filter_ && is_region_filtered(location);
+}
+
+bool io_graph_builder::is_region_filtered(const otf2::definition::location& location)
+{
+    const auto& scope = region_scopes_.top(location);
+    return scope.excluded || (has_included_regions_ && !scope.included);
+}
+
+bool io_graph_builder::is_file_filtered(const otf2::definition::io_file& file)
+{
+    const typename otf2::reference<otf2::definition::io_file>::ref_type idx = file.ref();
+    if (idx >= resolved_files_.size())
+    {
+        resolved_files_.resize(idx + 1, false);
+        filtered_files_.resize(idx + 1, false);
+    }
+    if (!resolved_files_[idx])
+    {
+        // files without a handle, e.g. just deleted, are resolved on first use
+        resolved_files_[idx] = true;
+        filtered_files_[idx] = config_.filter.is_path_filtered(file.name().str());
+    }
+    return filtered_files_[idx];
+}
+
+void io_graph_builder::compile_filter(const otf2::reader::reader& rdr)
+{
+    const auto& filter = config_.filter;
+    auto mark = [](std::vector<bool>& table, std::size_t ref) {
+        if (table.size() <= ref) {
+            table.resize(ref + 1, false);
+        }
+        table[ref] = true;
+    };
+
+    for (const auto& paradigm : rdr.io_paradigms())
+    {
+        // all layers are kept, regardless of their paradigm
+        if (!config_.keep_all_layers && filter.is_paradigm_filtered(paradigm.name().str())) {
+            mark(filtered_paradigms_, paradigm.ref());
+        }
+    }
+
+    std::size_t num_filtered_handles = 0;
+    for (const auto& handle : rdr.io_handles())
+    {
+        if ((!config_.keep_all_layers && filter.is_paradigm_filtered(handle.paradigm().name().str()))
+                || filter.is_path_filtered(get_handle_name(handle))) {
+            mark(filtered_handles_, handle.ref());
+            ++num_filtered_handles;
+        }
+        // resolve the path filter of the file once instead of per event
+        is_file_filtered(handle.file());
+    }
+
+    has_included_regions_ = !filter.included_regions.empty();
+    has_region_filter_ = has_included_regions_ || !filter.excluded_regions.empty();
+    if (has_region_filter_)
+    {
+        for (const auto& region : rdr.regions())
+        {
+            const auto name = region.name().str();
+            if (filter.included_regions.count(name) > 0) {
+                mark(included_regions_, region.ref());
+            }
+            if (filter.excluded_regions.count(name) > 0) {
+                mark(excluded_regions_, region.ref());
+            }
+        }
+    }
+
+    logging::debug() << "Filter " << filter << "drops " << num_filtered_handles
+                     << " of " << rdr.io_handles().size() << " I/O handles";
+}
+
 //FIXME: get_io_handle_name would be a better name since we actually work on a `io_handle`.
 std::string io_graph_builder::get_handle_name(const otf2::definition::io_handle& handle) const
 {
@@ -111,186 +391,444 @@ std::string io_graph_builder::get_handle_name(const otf2::definition::io_handle&
     return handle.name().str();
 }
 
+offset_tracker& io_graph_builder::file_position(const otf2::definition::location& location,
+                                                const otf2::definition::io_handle& handle)
+{
+    auto position = file_positions_.find(location, handle.ref());
+    if (position == nullptr)
+    {
+        auto tracker = std::make_shared<offset_tracker>();
+        file_positions_.insert(location, handle.ref(), tracker);
+        return *tracker;
+    }
+    return **position;
+}
+
+std::uint64_t io_graph_builder::collective_io_comm(const otf2::definition::comm& comm)
+{
+    const auto ref = static_cast<std::uint64_t>(comm.ref());
+    if (collective_io_members_.count(ref) == 0)
+    {
+        auto members = comm.has_self_group() ? comm.self_group().members()
+                                             : comm.group().members();
+        // the call is restricted to the selected locations
+        members.erase(std::remove_if(members.begin(), members.end(),
+                        [this](std::uint64_t m) { return !is_selected(m); }),
+                        members.end());
+        collective_io_members_.emplace(ref, members);
+    }
+    return ref;
+}
+
+held_lock& io_graph_builder::hold_lock(const otf2::definition::location& location,
+                                        const otf2::definition::io_handle& handle,
+                                        otf2::common::lock_type type,
+                                        otf2::chrono::time_point requested,
+                                        otf2::chrono::time_point acquired)
+{
+    const auto key = lock_key { handle.ref(), type };
+    held_lock lock;
+    auto& interval = lock.interval;
+    interval.proc_id = location.ref();
+    interval.filename = get_handle_name(handle);
+    interval.handle = handle.ref();
+    interval.type = type;
+    interval.requested = requested;
+    interval.acquired = acquired;
+    const auto tries = lock_tries_.find(location, key);
+    if (tries != nullptr)
+    {
+        // polled with unsuccessful tries before getting the lock
+        interval.requested = std::min(interval.requested, tries->first);
+        interval.failed_tries = tries->count;
+        lock_tries_.erase(location, key);
+    }
+    const auto status = handle_status_.find(location, handle.ref());
+    if (status != nullptr) {
+        interval.status_flags = *status;
+    }
+    held_locks_.insert(location, key, lock);
+    return *held_locks_.find(location, key);
+}
+
+bool io_graph_builder::release_lock(const otf2::definition::location& location,
+                                    const lock_key& key,
+                                    otf2::chrono::time_point tp)
+{
+    auto held = held_locks_.find(location, key);
+    if (held == nullptr) {
+        return false;
+    }
+    held->interval.released = tp;
+    lock_intervals_.push_back(std::move(held->interval));
+    held_locks_.erase(location, key);
+    return true;
+}
+
+void io_graph_builder::link_layers(const otf2::definition::location& location,
+                                    const otf2::definition::io_handle& handle,
+                                    VertexDescriptor vd,
+                                    const std::vector<VertexDescriptor>& children)
+{
+    if (!config_.keep_all_layers) {
+        return;
+    }
+    handle_vertices_.insert(location, handle.ref(), vd);
+    for (const auto child : children)
+    {
+        boost::get<io_event_property>(graph_[child].property).parent_event = vd;
+    }
+    if (!handle.has_parent()) {
+        return;
+    }
+    // a nested operation completes before the operation of the parent
+    // handle it is part of, which is linked once it completes
+    const auto matching_id = handle_operations_.find(location, handle.parent().ref());
+    if (matching_id != nullptr)
+    {
+        auto parent_op = find_io_operation(location, handle.parent(), *matching_id);
+        if (parent_op != nullptr)
+        {
+            parent_op->children.push_back(vd);
+            return;
+        }
+    }
+    const auto parent_vd = handle_vertices_.find(location, handle.parent().ref());
+    if (parent_vd != nullptr) {
+        boost::get<io_event_property>(graph_[vd].property).parent_event = *parent_vd;
+    }
+}
+
 // ==================== Event callbacks ====================
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::enter& evt)
 {
+    COUNT_EVENT(enter)
     logging::trace() << "Found enter event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    // keep the call stacks of regions entered before the window begins
+    if (evt.timestamp() > config_.window_end) {
+        event_guard.filtered();
+        return;
+    }
 
-    check_time(evt.timestamp());
+    if (in_window(evt.timestamp())) {
+        check_time(evt.timestamp());
+    }
     call_stack_.enqueue(location, stack_frame(evt.timestamp(), otf2::chrono::duration(0)));
     // TODO: not sure if just save the name as string is that clever
     region_name_queue_.push(location, evt.region().name().str());
+    if (has_region_filter_)
+    {
+        // a region called from an included or excluded region is within it as well
+        auto scope = region_scopes_.empty(location) ? region_scope() : region_scopes_.top(location);
+        scope.included = scope.included || is_set(included_regions_, evt.region().ref());
+        scope.excluded = scope.excluded || is_set(excluded_regions_, evt.region().ref());
+        region_scopes_.push(location, scope);
+    }
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::leave& evt)
 {
+    COUNT_EVENT(leave)
     logging::trace() << "Found leave event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    if (evt.timestamp() > config_.window_end) {
+        event_guard.filtered();
+        return;
+    }
 
-    check_time(evt.timestamp());
+    if (in_window(evt.timestamp())) {
+        check_time(evt.timestamp());
+    }
     auto cur_frame = call_stack_.front(location);
     auto duration = evt.timestamp() - cur_frame.enter;
     if (cur_frame.vertex != IoGraph::null_vertex())
     {
         auto& cur_vertex = graph_[cur_frame.vertex];
-        //cur_vertex.duration = duration;
-        cur_vertex.duration = {duration, cur_frame.enter, evt.timestamp()};
+        if (cur_vertex.duration.enter == otf2::chrono::armageddon()) {
+            //cur_vertex.duration = duration;
+            cur_vertex.duration = {duration, cur_frame.enter, evt.timestamp()};
+        }
+        else {
+            // vertex of a compacted run, accumulate the time spent in all
+            // folded calls and extend the span to the current leave.
+            cur_vertex.duration.duration += duration;
+            cur_vertex.duration.leave = evt.timestamp();
+        }
     }
     else {
         logging::trace() << "Invalid vertex descriptor";
     }
 
-    total_time_ += duration;
-
-    if (evt.region().role() == otf2::common::role_type::file_io)
-    {
-        total_file_io_time_ += duration;
-    }
-    else if (evt.region().role() == otf2::common::role_type::file_io_metadata)
+    // just account regions which are completely within the window
+    if (in_window(cur_frame.enter))
     {
-        total_file_io_metadata_time_ += duration;
+        total_time_ += duration;
+
+        if (evt.region().role() == otf2::common::role_type::file_io)
+        {
+            total_file_io_time_ += duration;
+        }
+        else if (evt.region().role() == otf2::common::role_type::file_io_metadata)
+        {
+            total_file_io_metadata_time_ += duration;
+        }
     }
 
     // delete saved region name if leave event is reached
     region_name_queue_.pop(location);
+    if (has_region_filter_)
+    {
+        region_scopes_.pop(location);
+    }
     call_stack_.dequeue(location);
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_operation_begin& evt)
 {
+    COUNT_EVENT(io_operation_begin)
     logging::trace() << "Found io_operation_begin event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
-    //Filter MPI-IO - events we just interesseted in POSIX I/O
-    if (evt.handle().paradigm().name().str() == "MPI-IO")
+    FILTER_WINDOW
+    // drop filtered paradigms, files and regions, by default MPI-IO,
+    // since we are just interested in POSIX I/O.
+    if (is_filtered(location, evt.handle()))
     {
-        logging::debug() << "FOUND MPI-IO ... skip!";
+        event_guard.filtered();
         return;
     }
 
     // here we just save the event for later.
     // An I/O operation will be merged into one single vertex if the
     // corresponding complete event occurs.
-    io_ops_started_.enqueue(location, evt);
+    pending_io_operation op;
+    op.begin = evt;
+    op.region_name = region_name_queue_.top(location);
+    // the operation starts at the position of its begin, non-blocking
+    // operations may complete in any order
+    auto& position = file_position(location, evt.handle());
+    op.offset_begin = position.get();
+    if (evt.operation_mode() != otf2::common::io_operation_mode_type::flush) {
+        position.inc(evt.bytes_request());
+    }
+    // without a communicator the participants of the call are unknown, it
+    // is treated like an independent operation
+    if (config_.aggregate_collective_io && is_collective(evt.operation_flag())
+            && evt.handle().comm().is_valid()) {
+        op.collective_comm = collective_io_comm(evt.handle().comm());
+    }
+    const auto key = io_operation_key { evt.handle().ref(), evt.matching_id() };
+    if (config_.keep_all_layers) {
+        handle_operations_.insert(location, evt.handle().ref(), evt.matching_id());
+    }
+    if (!io_ops_started_.insert(location, key, op)) {
+        logging::warn() << "I/O operation with matching id " << evt.matching_id()
+            << " began again before its completion on location #" << location.ref();
+    }
+}
+
+pending_io_operation*
+io_graph_builder::find_io_operation(const otf2::definition::location& location,
+                                    const otf2::definition::io_handle& handle,
+                                    std::uint64_t matching_id)
+{
+    return io_ops_started_.find(location, io_operation_key { handle.ref(), matching_id });
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_operation_complete& evt)
 {
+    COUNT_EVENT(io_operation_complete)
     logging::trace() << "Found io_operation_complete event to location #" << location.ref() << " @"
                         << evt.timestamp();
     FILTER_RANK
+    FILTER_WINDOW
 
 
-    //Filter MPI-IO - events we just interesseted in POSIX I/O
-    if (evt.handle().paradigm().name().str() == "MPI-IO")
+    // drop filtered paradigms, files and regions, by default MPI-IO,
+    // since we are just interested in POSIX I/O.
+    if (is_filtered(location, evt.handle()))
     {
-        logging::debug() << "FOUND MPI-IO ... skip!";
+        event_guard.filtered();
         return;
     }
+    const auto key = io_operation_key { evt.handle().ref(), evt.matching_id() };
+    const auto pending = io_ops_started_.find(location, key);
+    if (pending == nullptr)
+    {
+        // the operation began before the time window
+        event_guard.filtered();
+        return;
+    }
+    event_guard.bytes(evt.bytes_request());
     // get corresponding begin_operation
-    auto& begin_evt = io_ops_started_.front(location);
-    // matching id seems to be always the same, check for equality anyhow.
-    assert(evt.matching_id() == begin_evt.matching_id());
+    const auto begin_evt = pending->begin;
     const auto name = get_handle_name(evt.handle());
-    const auto region_name = region_name_queue_.top(location);
     //Check whether this is a read, write or flush event.
-    io_event_kind kind = io_event_kind::none;
-    switch (begin_evt.operation_mode())
+    const auto kind = to_event_kind(begin_evt.operation_mode());
+    const auto offset_begin = pending->offset_begin;
+    // the position was advanced by the requested bytes at the begin
+    auto offset_end = offset_begin;
+    if (kind == io_event_kind::read || kind == io_event_kind::write)
     {
-        case otf2::common::io_operation_mode_type::read:
-            kind = io_event_kind::read;
-            // increment offset for read ops
-            offset_map_.get_value(location, name).inc(evt.bytes_request());
-            break;
-        case otf2::common::io_operation_mode_type::write:
-            kind = io_event_kind::write;
-            // increment offset for write ops
-            offset_map_.get_value(location, name).inc(evt.bytes_request());
-            break;
-        case otf2::common::io_operation_mode_type::flush:
-            kind = io_event_kind::flush;
-            break;
+        offset_end += evt.bytes_request();
+        auto& position = file_position(location, evt.handle());
+        if (evt.bytes_request() < begin_evt.bytes_request()
+                && position.get() == offset_begin + begin_evt.bytes_request())
+        {
+            // short read or write and no operation began since, continue
+            // where the transfer stopped
+            position.set(offset_end);
+        }
     }
 
     auto duration = evt.timestamp() - begin_evt.timestamp();
     //use end timestamp so that, end_t - duration.count() == start
-    const auto vt = io_event_property(location.ref(),
+    auto vt = io_event_property(location.ref(),
                                     name,
-                                    region_name,
+                                    pending->region_name,
                                     evt.handle().paradigm().name().str(),
                                     begin_evt.bytes_request(),
                                     evt.bytes_request(),
-                                    offset_map_.get_value(location, name).get(), // offset
-                                    //0, /* offset */
+                                    offset_end, // offset
                                     io_operation_option_container(
                                         begin_evt.operation_mode(),
                                         begin_evt.operation_flag()),
                                     kind,
                                     duration,
                                     evt.timestamp());
+    const auto collective_comm = pending->collective_comm;
+    // move, the pending operation is erased before the vertex is added
+    const auto children = std::move(pending->children);
+    const auto is_collective_io = collective_comm != std::numeric_limits<std::uint64_t>::max();
+    if (pending->issued)
+    {
+        // non-blocking operation, the vertex spans from begin to completion
+        // instead of the region the completion was detected in.
+        vt.async = io_async_info(begin_evt.timestamp(), pending->issued.get(),
+                                    evt.timestamp(), pending->num_tests);
+        io_ops_started_.erase(location, key);
+        const auto descriptor = graph_.add_vertex(otf2_trace_event(vt));
+        graph_[descriptor].duration = { duration, begin_evt.timestamp(), evt.timestamp() };
+        build_edge(descriptor, location);
+        link_layers(location, evt.handle(), descriptor, children);
+        if (is_collective_io) {
+            collective_ios_.enqueue(location, collective_io_candidate { descriptor, collective_comm });
+        }
+        return;
+    }
+    io_ops_started_.erase(location, key);
+    // a collective operation keeps its own vertex, it is linked to its call
+    if (config_.compact_io && !is_collective_io
+            && (kind == io_event_kind::read || kind == io_event_kind::write))
+    {
+        if (fold_io_operation(location, vt, offset_begin))
+        {
+            event_guard.converted();
+            call_stack_.front(location).vertex = edge_points_.front(location);
+            link_layers(location, evt.handle(), edge_points_.front(location), children);
+            return;
+        }
+        vt.range = io_range(offset_begin, evt.bytes_request(), duration, evt.timestamp());
+    }
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
+    link_layers(location, evt.handle(), descriptor, children);
     call_stack_.front(location).vertex = descriptor;
-    io_ops_started_.dequeue(location);
+    if (is_collective_io) {
+        collective_ios_.enqueue(location, collective_io_candidate { descriptor, collective_comm });
+    }
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_acquire_lock& evt)
 {
+    COUNT_EVENT(io_acquire_lock)
     logging::trace() << "Found io_acquire_lock event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+
+    if (is_filtered(location, evt.handle()))
+    {
+        event_guard.filtered();
+        return;
+    }
+
+    auto held = held_locks_.find(location, lock_key { evt.handle().ref(), evt.lock_type() });
+    if (held != nullptr) {
+        // nested acquisition of a lock which is already held
+        ++held->depth;
+        return;
+    }
+    // the lock was requested when the locking call, e.g. fcntl, was entered
+    const auto requested = call_stack_.empty(location) ? evt.timestamp()
+                                                        : call_stack_.front(location).enter;
+    hold_lock(location, evt.handle(), evt.lock_type(), requested, evt.timestamp());
+    event_guard.converted();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_change_status_flag& evt)
 {
+    COUNT_EVENT(io_change_status_flag)
     logging::trace() << "Found io_change_status_flag event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+
+    if (is_filtered(location, evt.handle()))
+    {
+        event_guard.filtered();
+        return;
+    }
+    // no window filter, the flags are still valid for locks within the window
+    handle_status_.insert(location, evt.handle().ref(), evt.status_flags());
+    event_guard.converted();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_create_handle& evt)
 {
+    COUNT_EVENT(io_create_handle)
     logging::trace() << "Found io_create_handle event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
 
-    //Filter MPI-IO - events we just interesseted in POSIX I/O
-    if (evt.handle().paradigm().name().str() == "MPI-IO")
+    // drop filtered paradigms, files and regions, by default MPI-IO,
+    // since we are just interested in POSIX I/O.
+    if (is_filtered(location, evt.handle()))
     {
-        logging::debug() << "FOUND MPI-IO ... skip!";
+        event_guard.filtered();
         return;
     }
+    // locks may be taken on the handles of every layer
+    handle_status_.insert(location, evt.handle().ref(), evt.status_flags());
     // check for parent! to avoid duplication
-    if (evt.handle().has_parent()) {
+    if (evt.handle().has_parent() && !config_.keep_all_layers) {
         //logging::debug() << "handle has a parent! ... discard";
         return;
         // Since we already have the parent handle recorded... discard!
-        // FIXME: This is not quiet correct! How handle more
-        // sophisitcated handles? like hdf5.
+        // Use `keep_all_layers` to keep the handles of every layer, e.g. hdf5.
     }
 
     const auto name = get_handle_name(evt.handle());
-    // check that there is no existing offset_tracker for this file on this location
-    // create new offset tracker
-
-    offset_map_.get_value(location, name) = offset_tracker();
+    // a new handle starts at offset 0, a reused handle reference gets a
+    // fresh position as well
+    file_positions_.insert(location, evt.handle().ref(), std::make_shared<offset_tracker>());
 
     const auto region_name = region_name_queue_.top(location);
     const auto vt = io_event_property(location.ref(),
@@ -299,7 +837,7 @@ void io_graph_builder::event(const otf2::definition::location& location,
                                     evt.handle().paradigm().name().str(),
                                     0, /* request size */
                                     0, /* response size */
-                                    offset_map_.get_value(location, name).get(), /* offset */
+                                    file_position(location, evt.handle()).get(), /* offset */
                                     rabbitxx::io_creation_option_container(
                                         evt.status_flags(),
                                         evt.creation_flags(),
@@ -309,16 +847,25 @@ void io_graph_builder::event(const otf2::definition::location& location,
                                     evt.timestamp());
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
+    link_layers(location, evt.handle(), descriptor);
     call_stack_.front(location).vertex = descriptor;
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_delete_file& evt)
 {
+    COUNT_EVENT(io_delete_file)
     logging::trace() << "Found io_delete_file event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+
+    if (is_filtered(location, evt.paradigm(), evt.file()))
+    {
+        event_guard.filtered();
+        return;
+    }
 
     // check if we have a file name or a "non-file" handle
     // TODO: here we have no handle, but we can the io_file definition directly
@@ -331,9 +878,7 @@ void io_graph_builder::event(const otf2::definition::location& location,
     }
 
     const auto region_name = region_name_queue_.top(location);
-    // delete offset_tracker
-    size_t res = offset_map_[location.ref()].erase(name);
-    assert(res > 0);
+    // handles of the deleted file stay valid and keep their position
     const auto vt = io_event_property(location.ref(),
                                     name,
                                     region_name,
@@ -353,30 +898,37 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_destroy_handle& evt)
 {
+    COUNT_EVENT(io_destroy_handle)
     logging::trace() << "Found io_destroy_handle event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
 
-    //Filter MPI-IO - events we just interesseted in POSIX I/O
-    if (evt.handle().paradigm().name().str() == "MPI-IO")
+    // drop filtered paradigms, files and regions, by default MPI-IO,
+    // since we are just interested in POSIX I/O.
+    if (is_filtered(location, evt.handle()))
     {
-        logging::debug() << "FOUND MPI-IO ... skip!";
+        event_guard.filtered();
         return;
     }
+    // closing a handle releases its locks
+    handle_status_.erase(location, evt.handle().ref());
+    release_lock(location, lock_key { evt.handle().ref(), otf2::common::lock_type::exclusive },
+                evt.timestamp());
+    release_lock(location, lock_key { evt.handle().ref(), otf2::common::lock_type::shared },
+                evt.timestamp());
     //check for parent! avoid duplication
-    if (evt.handle().has_parent()) {
+    if (evt.handle().has_parent() && !config_.keep_all_layers) {
         //logging::debug() << "handle has a parent! ... discard!";
         return;
         // Since we already have the parent handle recorded... discard!
-        // FIXME: This is not quiet correct! How handle more
-        // sophisitcated handles? like hdf5.
+        // Use `keep_all_layers` to keep the handles of every layer, e.g. hdf5.
     }
 
     const auto name = get_handle_name(evt.handle());
-    // delete offset_tracker
-    size_t res = offset_map_[location.ref()].erase(name);
-    assert(res > 0);
+    // duplicates of this handle keep their shared position
+    file_positions_.erase(location, evt.handle().ref());
     const auto region_name = region_name_queue_.top(location);
     const auto vt = io_event_property(location.ref(),
                                     name,
@@ -391,16 +943,31 @@ void io_graph_builder::event(const otf2::definition::location& location,
                                     evt.timestamp());
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
+    link_layers(location, evt.handle(), descriptor);
     call_stack_.front(location).vertex = descriptor;
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_duplicate_handle& evt)
 {
+    COUNT_EVENT(io_duplicate_handle)
     logging::trace() << "Found io_duplicate_handle event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+
+    if (is_filtered(location, evt.new_handle()))
+    {
+        event_guard.filtered();
+        return;
+    }
+
+    // the duplicate shares the file position with the old handle, like dup(2)
+    file_position(location, evt.old_handle());
+    const auto shared_position = *file_positions_.find(location, evt.old_handle().ref());
+    file_positions_.insert(location, evt.new_handle().ref(), shared_position);
+    handle_status_.insert(location, evt.new_handle().ref(), evt.status_flags());
 
     const auto name = get_handle_name(evt.new_handle());
     const auto region_name = region_name_queue_.top(location);
@@ -410,64 +977,130 @@ void io_graph_builder::event(const otf2::definition::location& location,
                                     evt.new_handle().paradigm().name().str(),
                                     0, /* request size */
                                     0, /* response size */
-                                    0, /* offset */
+                                    shared_position->get(), /* offset */
                                     io_creation_option_container(evt.status_flags()),
                                     io_event_kind::dup,
                                     boost::none,
                                     evt.timestamp());
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
+    link_layers(location, evt.new_handle(), descriptor);
     call_stack_.front(location).vertex = descriptor;
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_operation_cancelled& evt)
 {
+    COUNT_EVENT(io_operation_cancelled)
     logging::trace() << "Found io_operation_cancelled event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+
+    // a cancelled operation transferred no data, forget it
+    const auto key = io_operation_key { evt.handle().ref(), evt.matching_id() };
+    const auto pending = io_ops_started_.find(location, key);
+    if (pending == nullptr) {
+        // began before the window or filtered
+        event_guard.filtered();
+        return;
+    }
+    auto& position = file_position(location, evt.handle());
+    if (position.get() == pending->offset_begin + pending->begin.bytes_request()) {
+        // no operation began since, give back the reserved bytes
+        position.set(pending->offset_begin);
+    }
+    io_ops_started_.erase(location, key);
+    event_guard.filtered();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_operation_issued& evt)
 {
+    COUNT_EVENT(io_operation_issued)
     logging::trace() << "Found io_operation_issued event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+
+    // the call of a non-blocking operation returned, the operation is in flight now
+    const auto pending = find_io_operation(location, evt.handle(), evt.matching_id());
+    if (pending == nullptr) {
+        // began before the window or filtered
+        return;
+    }
+    pending->issued = evt.timestamp();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_operation_test& evt)
 {
+    COUNT_EVENT(io_operation_test)
     logging::trace() << "Found io_operation_test event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+
+    // unsuccessful test for completion of a non-blocking operation
+    const auto pending = find_io_operation(location, evt.handle(), evt.matching_id());
+    if (pending != nullptr) {
+        ++pending->num_tests;
+    }
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_release_lock& evt)
 {
+    COUNT_EVENT(io_release_lock)
     logging::trace() << "Found io_release_lock event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+
+    if (is_filtered(location, evt.handle()))
+    {
+        event_guard.filtered();
+        return;
+    }
+
+    const auto key = lock_key { evt.handle().ref(), evt.lock_type() };
+    auto held = held_locks_.find(location, key);
+    if (held == nullptr)
+    {
+        // a release without acquisition means the last try got the lock
+        const auto tries = lock_tries_.find(location, key);
+        if (tries == nullptr) {
+            // acquired before the window
+            return;
+        }
+        const auto first = tries->first;
+        const auto last = tries->last;
+        --tries->count;
+        held = &hold_lock(location, evt.handle(), evt.lock_type(), first, last);
+    }
+    if (--held->depth > 0) {
+        return;
+    }
+    // no window filter, a lock acquired within the window is released after it
+    release_lock(location, key, evt.timestamp());
+    event_guard.converted();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_seek& evt)
 {
+    COUNT_EVENT(io_seek)
     logging::trace() << "Found io_seek event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
 
-    //Filter MPI-IO - events we just interesseted in POSIX I/O
-    if (evt.handle().paradigm().name().str() == "MPI-IO")
+    // drop filtered paradigms, files and regions, by default MPI-IO,
+    // since we are just interested in POSIX I/O.
+    if (is_filtered(location, evt.handle()))
     {
-        logging::debug() << "FOUND MPI-IO ... skip!";
+        event_guard.filtered();
         return;
     }
     const auto name = get_handle_name(evt.handle());
@@ -478,34 +1111,63 @@ void io_graph_builder::event(const otf2::definition::location& location,
     //       offset = offset_result
 
     // set offset to seek result!
-    offset_map_.get_value(location, name).set(evt.offset_result());
+    auto& position = file_position(location, evt.handle());
+    position.set(evt.offset_result());
 
     auto vt = io_event_property(location.ref(), name, region_name,
                                     evt.handle().paradigm().name().str(),
                                     evt.offset_request(),
                                     evt.offset_result(),
-                                    offset_map_.get_value(location, name).get(), //offset
+                                    position.get(), //offset
                                     evt.seek_option(),
                                     io_event_kind::seek,
                                     boost::none,
                                     evt.timestamp());
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
+    link_layers(location, evt.handle(), descriptor);
     call_stack_.front(location).vertex = descriptor;
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::io_try_lock& evt)
 {
+    COUNT_EVENT(io_try_lock)
     logging::trace() << "Found io_try_lock event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+
+    if (is_filtered(location, evt.handle()))
+    {
+        event_guard.filtered();
+        return;
+    }
+
+    const auto key = lock_key { evt.handle().ref(), evt.lock_type() };
+    if (held_locks_.find(location, key) != nullptr) {
+        return;
+    }
+    // count the try as unsuccessful until the lock is acquired or released
+    auto tries = lock_tries_.find(location, key);
+    if (tries == nullptr)
+    {
+        lock_attempts attempts;
+        attempts.first = call_stack_.empty(location) ? evt.timestamp()
+                                                    : call_stack_.front(location).enter;
+        lock_tries_.insert(location, key, attempts);
+        tries = lock_tries_.find(location, key);
+    }
+    ++tries->count;
+    tries->last = evt.timestamp();
+    event_guard.converted();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_collective_begin& evt)
 {
+    COUNT_EVENT(mpi_collective_begin)
     logging::trace() << "Found mpi_collective_begin event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
@@ -517,9 +1179,11 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_collective_end& evt)
 {
+    COUNT_EVENT(mpi_collective_end)
     logging::trace() << "Found mpi_collective_end event to location #" << location.ref() << " @"
                         << evt.timestamp();
     FILTER_RANK
+    FILTER_WINDOW
 
     const auto region_name = region_name_queue_.top(location);
     std::vector<std::uint64_t> members;
@@ -539,8 +1203,22 @@ void io_graph_builder::event(const otf2::definition::location& location,
 
     assert(!members.empty()); // getting sure!
 
+    auto coll_op = collective(evt.root(), members);
+    if (!config_.locations.empty())
+    {
+        // restrict the collective to the selected locations
+        members.erase(std::remove_if(members.begin(), members.end(),
+                        [this](std::uint64_t m) { return !is_selected(m); }),
+                        members.end());
+        if (members.size() <= 1) {
+            // no other selected location is involved, no synchronization
+            return;
+        }
+        coll_op = is_selected(evt.root()) ? collective(evt.root(), members) : collective(members);
+    }
+
     const auto vt = sync_event_property(location.ref(), region_name,
-                                        collective(evt.root(), members),
+                                        coll_op,
                                         evt.timestamp());
     const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
     build_edge(descriptor, location);
@@ -551,10 +1229,21 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_ireceive& evt)
 {
+    COUNT_EVENT(mpi_ireceive)
     logging::trace() << "Found mpi_ireceive event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    // mpi_ireceive marks the completion of the request, e.g. in MPI_Wait,
+    // which is the synchronization point.
+    requests_.erase(location, evt.request_id());
+    FILTER_WINDOW
+    // communication with unselected locations is no synchronization within the subset
+    if (!is_selected(evt.sender())) {
+        event_guard.filtered();
+        return;
+    }
+    event_guard.bytes(evt.msg_length());
 
     const auto region_name = region_name_queue_.top(location);
     const auto vt = sync_event_property(location.ref(), region_name,
@@ -571,51 +1260,85 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_ireceive_request& evt)
 {
+    COUNT_EVENT(mpi_ireceive_request)
     logging::trace() << "Found mpi_ireceive_request event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
-    //graph_.add_vertex();
+    pending_request req;
+    req.issued = evt.timestamp();
+    if (!requests_.insert(location, evt.request_id(), req)) {
+        logging::warn() << "request #" << evt.request_id() << " at " << location
+                        << " issued again before its completion";
+    }
 }
 
-//TODO
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_isend& evt)
 {
+    COUNT_EVENT(mpi_isend)
     logging::trace() << "Found mpi_isend event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
-
-    const auto region_name = region_name_queue_.top(location);
-    const auto vt = sync_event_property(location.ref(), region_name,
-                                        peer2peer(evt.receiver(), evt.msg_tag(),
-                                                    evt.msg_length(),
-                                                    evt.request_id()),
-                                        evt.timestamp());
-    const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
-    build_edge(descriptor, location);
-    synchronizations_.enqueue(location, descriptor);
-    call_stack_.front(location).vertex = descriptor;
+    // communication with unselected locations is no synchronization within the subset
+    if (!is_selected(evt.receiver())) {
+        event_guard.filtered();
+        return;
+    }
+    event_guard.bytes(evt.msg_length());
+
+    // The send synchronizes at its completion, remember it until then.
+    pending_request req;
+    req.op = peer2peer(evt.receiver(), evt.msg_tag(), evt.msg_length(), evt.request_id());
+    req.issued = evt.timestamp();
+    if (!requests_.insert(location, evt.request_id(), req)) {
+        logging::warn() << "request #" << evt.request_id() << " at " << location
+                        << " issued again before its completion";
+    }
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_isend_complete& evt)
 {
+    COUNT_EVENT(mpi_isend_complete)
     logging::trace() << "Found mpi_isend_complete event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
-    //graph_.add_vertex();
+    const auto req = requests_.find(location, evt.request_id());
+    if (req == nullptr || !req->op) {
+        // send to an unselected location, or issued before the trace starts
+        event_guard.filtered();
+        return;
+    }
+    const auto op = *req->op;
+    requests_.erase(location, evt.request_id());
+    FILTER_WINDOW
+
+    const auto region_name = region_name_queue_.top(location);
+    const auto vt = sync_event_property(location.ref(), region_name, op, evt.timestamp());
+    const auto& descriptor = graph_.add_vertex(otf2_trace_event(vt));
+    build_edge(descriptor, location);
+    synchronizations_.enqueue(location, descriptor);
+    call_stack_.front(location).vertex = descriptor;
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_receive& evt)
 {
+    COUNT_EVENT(mpi_receive)
     logging::trace() << "Found mpi_receive event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+    // communication with unselected locations is no synchronization within the subset
+    if (!is_selected(evt.sender())) {
+        event_guard.filtered();
+        return;
+    }
+    event_guard.bytes(evt.msg_length());
 
     const auto region_name = region_name_queue_.top(location);
     const auto vt = sync_event_property(location.ref(), region_name,
@@ -631,15 +1354,20 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_request_cancelled& evt)
 {
+    COUNT_EVENT(mpi_request_cancelled)
     logging::trace() << "Found mpi_request_cancelled event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    // a cancelled request never synchronizes
+    requests_.erase(location, evt.request_id());
+    event_guard.filtered();
 }
 
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_request_test& evt)
 {
+    COUNT_EVENT(mpi_request_test)
     logging::trace() << "Found mpi_request_test event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
@@ -649,10 +1377,18 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::mpi_send& evt)
 {
+    COUNT_EVENT(mpi_send)
     logging::trace() << "Found mpi_send event to location #" << location.ref() << " @"
                         << evt.timestamp();
 
     FILTER_RANK
+    FILTER_WINDOW
+    // communication with unselected locations is no synchronization within the subset
+    if (!is_selected(evt.receiver())) {
+        event_guard.filtered();
+        return;
+    }
+    event_guard.bytes(evt.msg_length());
 
     const auto region_name = region_name_queue_.top(location);
     const auto vt = sync_event_property(location.ref(), region_name,
@@ -668,6 +1404,7 @@ void io_graph_builder::event(const otf2::definition::location& location,
 void io_graph_builder::event(const otf2::definition::location& location,
                     const otf2::event::unknown& evt)
 {
+    COUNT_EVENT(unknown)
     logging::warn() << "Found unknown event with timestamp " << evt.timestamp()
                     << " at " << location;
 
@@ -681,85 +1418,25 @@ void io_graph_builder::events_done(const otf2::reader::reader& rdr)
 {
     if (is_master())
     {
+        if (io_ops_started_.size() > 0) {
+            logging::debug() << io_ops_started_.size() << " I/O operations without completion";
+        }
+        if (requests_.size() > 0) {
+            logging::debug() << requests_.size() << " MPI requests without completion";
+        }
+        if (held_locks_.size() > 0) {
+            logging::debug() << held_locks_.size() << " locks without release";
+        }
         create_synthetic_end();
-        for (const auto& loc_events : synchronizations_)
-        {
-            // get property map of all properties
-            auto p_map = get(&otf2_trace_event::property, *graph_.get());
-            // iterate through all vertex desciptors of sync_events occuring on this location
-            for (const auto& v : loc_events.second)
-            {
-                auto& vertex = boost::get<sync_event_property>(get(p_map, v)); // get the corresponding sync event property
-                // Distinguish between sync_event_kind's atm. just collective and p2p.
-                if (vertex.comm_kind == sync_event_kind::collective)
-                {
-                    //logging::debug() << "vertex sync_event_kind is collective";
-                    auto coll_op = boost::get<collective>(vertex.op_data);
-                    if (coll_op.root() <= coll_op.members().size()) { // or just if (coll_op.has_root())
-                        // root rank is in the range of members
-                        if (vertex.proc_id != coll_op.root()) {
-                            continue; //draw edges only from root!
-                        }
-                    }
-                    for (const auto m : coll_op.members())
-                    {
-                        if (vertex.proc_id == m) {
-                            continue; // skip myself, do not draw cycles
-                        }
-                        //find corresponding collective for every participating location.
-                        auto it = std::find_if(synchronizations_[m].begin(), synchronizations_[m].end(),
-                                                [&p_map](const VertexDescriptor& vd)
-                                                {
-                                                    const auto sync_kind = boost::get<sync_event_property>(get(p_map, vd)).comm_kind;
-                                                    return sync_kind == sync_event_kind::collective;
-                                                });
-                        if (it == synchronizations_[m].end()) {
-                            logging::fatal() << "cannot find corresponding collective event for member: "
-                                << m << "\n" << vertex;
-                            return;
-                        }
-                        //TODO: ist gefundene collective auch member der aktuellen
-                        auto& trg_vertex = boost::get<sync_event_property>(get(p_map, *it));
-                        // set root event
-                        trg_vertex.root_event = v;
-                        graph_.add_edge(v, *it);
-                        synchronizations_[m].erase(it);
-                    }
-                }
-                else // peer2peer synchronization event
-                {
-                    //logging::debug() << "vertex sync_event_kind is p2p";
-                    assert(vertex.comm_kind == sync_event_kind::p2p);
-                    auto p2p_op = boost::get<peer2peer>(vertex.op_data);
-                    const auto remote = p2p_op.remote_process();
-                    auto it = std::find_if(synchronizations_[remote].begin(), synchronizations_[remote].end(),
-                                    [&p_map, &vertex](const VertexDescriptor& vd)
-                                    {
-                                        const auto sevt = boost::get<sync_event_property>(get(p_map, vd));
-                                        if (sevt.comm_kind != sync_event_kind::p2p) {
-                                            return false; //discard if not a p2p event
-                                        }
-                                        const auto p2pevt = boost::get<peer2peer>(sevt.op_data);
-                                        if (vertex.proc_id == p2pevt.remote_process()) {
-                                            //logging::debug() << "proc id: " << vertex.proc_id << " remote proc: " << p2pevt.remote_process();
-                                            //logging::debug() << "Selected p2p events: "  << vertex  << " -> "<<  sevt;
-                                            return true;
-                                        }
-                                        return false;
-                                    });
-                    if (it == synchronizations_[remote].end()) {
-                        logging::fatal() << "cannot find corresponding p2p event";
-                        return;
-                    }
-                    auto& trg_vertex = boost::get<sync_event_property>(get(p_map, *it));
-                    //set root event
-                    trg_vertex.root_event = v;
-                    graph_.add_edge(v, *it);
-                    synchronizations_[remote].erase(it);
-                }
-                // set sync event as root
-                vertex.root_event = v;
-            }
+        profile_scope scope("sync matching");
+        if (!match_synchronizations(graph_, synchronizations_, is_partial())) {
+            return;
+        }
+        if (!match_collective_io(graph_, collective_ios_, collective_io_members_, is_partial())) {
+            return;
+        }
+        if (!config_.locations.empty()) {
+            remap_process_ids();
         }
         // setting graph properties
         set_graph_properties();
@@ -771,7 +1448,9 @@ void io_graph_builder::events_done(const otf2::reader::reader& rdr)
 void io_graph_builder::definition(const otf2::definition::location& definition)
 {
     logging::trace() << "Found location defintion";
-    locations_.push_back(definition);
+    if (is_selected(definition.ref())) {
+        locations_.push_back(definition);
+    }
 }
 
 void io_graph_builder::definition(const otf2::definition::region& definition)
@@ -812,11 +1491,22 @@ void io_graph_builder::definition(const otf2::definition::unknown& definition)
 
 void io_graph_builder::definitions_done(const otf2::reader::reader& rdr)
 {
+    compile_filter(rdr);
+
+    mapping_.prepare(rdr.locations());
+    std::uint64_t num_events = 0;
     for(const auto& location : rdr.locations()) {
+        // read only the events of selected locations
+        if (!is_selected(location.ref())) {
+            continue;
+        }
+        num_events += location.num_events();
         //do rank mapping!
         mapping_.register_location(location);
         rdr.register_location(location);
     }
+    ingestion_.set_expected_events(num_events);
+    ingestion_.set_progress_interval(std::chrono::duration<double>(config_.progress_interval));
 
     const auto& str_refs = rdr.strings();
     for (const auto& fp : rdr.io_file_properties())
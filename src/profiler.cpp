@@ -0,0 +1,225 @@
+#include <rabbitxx/profiler.hpp>
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace rabbitxx
+{
+
+namespace detail
+{
+
+std::atomic<std::uint64_t> allocation_count {0};
+std::atomic<std::uint64_t> allocation_bytes {0};
+
+} // namespace detail
+
+} // namespace rabbitxx
+
+#ifdef RABBITXX_COUNT_ALLOCATIONS
+
+// Counting replacements of the global allocation functions.
+// Every heap allocation of the process goes through them, so they are only
+// compiled in on request.
+
+namespace
+{
+
+void* counted_alloc(std::size_t size)
+{
+    rabbitxx::detail::allocation_count.fetch_add(1, std::memory_order_relaxed);
+    rabbitxx::detail::allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    void* ptr = counted_alloc(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif // RABBITXX_COUNT_ALLOCATIONS
+
+namespace rabbitxx
+{
+
+namespace
+{
+
+std::chrono::nanoseconds to_nanoseconds(const timeval& tv)
+{
+    return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+}
+
+} // namespace
+
+resource_usage resource_usage::now()
+{
+    resource_usage usage;
+    usage.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+        usage.cpu = to_nanoseconds(ru.ru_utime) + to_nanoseconds(ru.ru_stime);
+        // ru_maxrss is given in kilobytes on Linux
+        usage.peak_rss = static_cast<std::uint64_t>(ru.ru_maxrss) * 1024;
+    }
+    usage.allocations = detail::allocation_count.load(std::memory_order_relaxed);
+    usage.allocated_bytes = detail::allocation_bytes.load(std::memory_order_relaxed);
+    return usage;
+}
+
+std::vector<std::size_t> profile::children(std::size_t parent) const
+{
+    std::vector<std::size_t> idxs;
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+        if (entries_[i].parent == parent) {
+            idxs.push_back(i);
+        }
+    }
+    return idxs;
+}
+
+std::size_t profile::find_or_add(std::size_t parent, const std::string& name)
+{
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+        if (entries_[i].parent == parent && entries_[i].name == name) {
+            return i;
+        }
+    }
+    profile_entry entry;
+    entry.name = name;
+    entry.parent = parent;
+    entry.depth = parent == profile_entry::no_parent ? 0 : entries_[parent].depth + 1;
+    entries_.push_back(entry);
+    return entries_.size() - 1;
+}
+
+namespace
+{
+
+void print_entry(std::ostream& os, const profile& prof, std::size_t idx)
+{
+    const auto& entry = prof[idx];
+    const auto to_ms = [](std::chrono::nanoseconds ns) {
+        return std::chrono::duration<double, std::milli>(ns).count();
+    };
+    os << std::string(2 * entry.depth, ' ') << entry.name << ": "
+        << std::fixed << std::setprecision(3)
+        << "wall " << to_ms(entry.wall) << " ms, "
+        << "cpu " << to_ms(entry.cpu) << " ms, "
+        << "peak rss +" << entry.peak_rss_delta / 1024 << " KiB";
+    if (profiler::counts_allocations())
+    {
+        os << ", " << entry.allocations << " allocations ("
+            << entry.allocated_bytes / 1024 << " KiB)";
+    }
+    if (entry.calls > 1) {
+        os << ", " << entry.calls << " calls";
+    }
+    os << "\n";
+    for (const auto child : prof.children(idx))
+    {
+        print_entry(os, prof, child);
+    }
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const profile& prof)
+{
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    for (const auto idx : prof.children(profile_entry::no_parent))
+    {
+        print_entry(os, prof, idx);
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+profiler& profiler::global()
+{
+    static profiler instance;
+    return instance;
+}
+
+void profiler::enter(const std::string& name)
+{
+    const auto parent = stack_.empty() ? profile_entry::no_parent : stack_.back().entry;
+    const auto idx = profile_.find_or_add(parent, name);
+    stack_.push_back(open_phase { idx, resource_usage::now() });
+}
+
+void profiler::leave()
+{
+    assert(!stack_.empty());
+    const auto end = resource_usage::now();
+    const auto phase = stack_.back();
+    stack_.pop_back();
+
+    auto& entry = profile_[phase.entry];
+    ++entry.calls;
+    entry.wall += end.wall - phase.start.wall;
+    entry.cpu += end.cpu - phase.start.cpu;
+    entry.peak_rss_delta += end.peak_rss - phase.start.peak_rss;
+    entry.allocations += end.allocations - phase.start.allocations;
+    entry.allocated_bytes += end.allocated_bytes - phase.start.allocated_bytes;
+}
+
+void profiler::reset()
+{
+    profile_ = profile();
+    stack_.clear();
+}
+
+} // namespace rabbitxx
@@ -0,0 +1,232 @@
+#include <rabbitxx/synthetic_graph.hpp>
+#include <rabbitxx/graph/builder/sync_matching.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace rabbitxx
+{
+
+namespace
+{
+
+using otf2::chrono::duration;
+using otf2::chrono::time_point;
+
+// durations of the synthetic events
+const auto io_duration = std::chrono::duration_cast<duration>(std::chrono::microseconds(10));
+const auto sync_duration = std::chrono::duration_cast<duration>(std::chrono::microseconds(20));
+const auto meta_duration = std::chrono::duration_cast<duration>(std::chrono::microseconds(5));
+
+class synthetic_builder
+{
+public:
+    explicit synthetic_builder(std::uint64_t num_procs)
+        : last_(num_procs, IoGraph::null_vertex())
+    {
+        root_ = graph_.add_vertex(otf2_trace_event(
+                    synthetic_event_property("Root", time_point(duration(0)))));
+    }
+
+    void add_io(std::uint64_t pid, const std::string& filename, const std::string& region,
+                io_event_kind kind, io_event_property::option_type option,
+                std::uint64_t bytes, std::uint64_t offset, time_point ts, duration dur)
+    {
+        // like the builder, the vertex stores the completion as timestamp
+        const auto vt = io_event_property(pid, filename, region, "POSIX", bytes, bytes, offset,
+                                          option, kind,
+                                          bytes > 0 ? boost::optional<duration>(dur) : boost::none,
+                                          ts + dur);
+        auto vd = graph_.add_vertex(otf2_trace_event(vt));
+        finish(pid, vd, ts, dur);
+        if (kind == io_event_kind::read || kind == io_event_kind::write) {
+            io_time_ += dur;
+        }
+        else {
+            io_metadata_time_ += dur;
+        }
+    }
+
+    void add_sync(std::uint64_t pid, const sync_event_property& vt, time_point ts)
+    {
+        auto vd = graph_.add_vertex(otf2_trace_event(vt));
+        finish(pid, vd, ts, sync_duration);
+        synchronizations_[pid].push_back(vd);
+    }
+
+    IoGraph finalize(std::uint64_t num_procs)
+    {
+        const auto end = graph_.add_vertex(otf2_trace_event(
+                    synthetic_event_property("End", time_point::max())));
+        for (const auto last : last_)
+        {
+            if (last != IoGraph::null_vertex()) {
+                graph_.add_edge(last, end);
+            }
+        }
+
+        graph::match_synchronizations(graph_, synchronizations_, false);
+
+        auto& info = graph_.get()->operator[](boost::graph_bundle);
+        info.total_time = total_time_;
+        info.io_time = io_time_;
+        info.io_metadata_time = io_metadata_time_;
+        info.first_event_time = first_;
+        info.last_event_time = last_ts_;
+        info.num_locations = num_procs;
+        info.locations.resize(num_procs);
+        std::iota(info.locations.begin(), info.locations.end(), 0);
+
+        return std::move(graph_);
+    }
+
+private:
+    // append the vertex to the chain of its process
+    void finish(std::uint64_t pid, VertexDescriptor vd, time_point ts, duration dur)
+    {
+        auto& vertex = graph_[vd];
+        vertex.duration.enter = ts;
+        vertex.duration.leave = ts + dur;
+        vertex.duration.duration = dur;
+
+        const auto from = last_[pid] == IoGraph::null_vertex() ? root_ : last_[pid];
+        graph_.add_edge(from, vd);
+        last_[pid] = vd;
+
+        total_time_ += dur;
+        first_ = std::min(first_, ts);
+        last_ts_ = std::max(last_ts_, ts + dur);
+    }
+
+    IoGraph graph_;
+    VertexDescriptor root_;
+    std::vector<VertexDescriptor> last_;
+    std::map<std::uint64_t, std::deque<VertexDescriptor>> synchronizations_;
+    duration total_time_ = duration(0);
+    duration io_time_ = duration(0);
+    duration io_metadata_time_ = duration(0);
+    time_point first_ = time_point::max();
+    time_point last_ts_ = time_point::min();
+};
+
+std::string synthetic_filename(const synthetic_graph_config& cfg, std::uint64_t pid)
+{
+    if (cfg.shared_file) {
+        return "/scratch/synthetic/shared.dat";
+    }
+    return "/scratch/synthetic/file." + std::to_string(pid) + ".dat";
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const synthetic_graph_config& cfg)
+{
+    os << std::boolalpha
+        << "procs: " << cfg.num_procs
+        << " phases: " << cfg.num_phases
+        << " io per phase: " << cfg.io_per_phase
+        << " comm size: " << cfg.comm_size
+        << " p2p density: " << cfg.p2p_density
+        << " collective density: " << cfg.collective_density
+        << " shared file: " << cfg.shared_file
+        << " bytes per io: " << cfg.bytes_per_io
+        << " seed: " << cfg.seed;
+    return os;
+}
+
+IoGraph make_synthetic_graph(const synthetic_graph_config& cfg)
+{
+    synthetic_builder builder(cfg.num_procs);
+    std::mt19937_64 rng(cfg.seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    const auto comm_size = cfg.comm_size == 0 ? cfg.num_procs : cfg.comm_size;
+    const auto phase_length = (cfg.io_per_phase + 1) * io_duration + 3 * sync_duration;
+    const auto write_option = io_operation_option_container(otf2::common::io_operation_mode_type::write);
+    const auto open_option = io_creation_option_container(otf2::common::io_status_flag_type::none,
+            otf2::common::io_creation_flag_type::create,
+            otf2::common::io_access_mode_type::write_only);
+
+    std::vector<std::uint64_t> offsets(cfg.num_procs, 0);
+    std::vector<std::uint64_t> procs(cfg.num_procs);
+    std::iota(procs.begin(), procs.end(), 0);
+
+    for (std::uint64_t pid = 0; pid < cfg.num_procs; ++pid)
+    {
+        builder.add_io(pid, synthetic_filename(cfg, pid), "open", io_event_kind::create,
+                open_option, 0, 0, time_point(duration(0)), meta_duration);
+    }
+
+    for (std::uint64_t phase = 0; phase < cfg.num_phases; ++phase)
+    {
+        const auto phase_begin = time_point(meta_duration + phase * phase_length);
+        // events are created in timestamp order, as the trace reader would do
+        for (std::uint64_t i = 0; i < cfg.io_per_phase; ++i)
+        {
+            const auto ts = phase_begin + i * io_duration;
+            for (std::uint64_t pid = 0; pid < cfg.num_procs; ++pid)
+            {
+                std::uint64_t start = offsets[pid];
+                if (cfg.shared_file) {
+                    // strided access, every process writes its own blocks
+                    start = ((phase * cfg.io_per_phase + i) * cfg.num_procs + pid) * cfg.bytes_per_io;
+                }
+                // like the builder, the offset is the file position after the write
+                builder.add_io(pid, synthetic_filename(cfg, pid), "write", io_event_kind::write,
+                        write_option, cfg.bytes_per_io, start + cfg.bytes_per_io, ts, io_duration);
+                offsets[pid] += cfg.bytes_per_io;
+            }
+        }
+
+        // p2p exchanges between random pairs
+        const auto p2p_ts = phase_begin + cfg.io_per_phase * io_duration;
+        std::shuffle(procs.begin(), procs.end(), rng);
+        for (std::uint64_t i = 0; i + 1 < procs.size(); i += 2)
+        {
+            if (coin(rng) >= cfg.p2p_density) {
+                continue;
+            }
+            const auto sender = std::min(procs[i], procs[i + 1]);
+            const auto receiver = std::max(procs[i], procs[i + 1]);
+            builder.add_sync(sender, sync_event_property(sender, "MPI_Send",
+                        peer2peer(receiver, phase, cfg.bytes_per_io), p2p_ts), p2p_ts);
+            builder.add_sync(receiver, sync_event_property(receiver, "MPI_Recv",
+                        peer2peer(sender, phase, cfg.bytes_per_io), p2p_ts), p2p_ts);
+        }
+
+        if (coin(rng) >= cfg.collective_density) {
+            continue;
+        }
+        const auto coll_ts = p2p_ts + sync_duration;
+        for (std::uint64_t first = 0; first < cfg.num_procs; first += comm_size)
+        {
+            const auto last = std::min(first + comm_size, cfg.num_procs);
+            if (last - first <= 1) {
+                // a single process sync with itself is no synchronization
+                continue;
+            }
+            std::vector<std::uint64_t> members(last - first);
+            std::iota(members.begin(), members.end(), first);
+            for (const auto pid : members)
+            {
+                builder.add_sync(pid, sync_event_property(pid, "MPI_Barrier",
+                            collective(members), coll_ts), coll_ts);
+            }
+        }
+    }
+
+    const auto close_ts = time_point(meta_duration + cfg.num_phases * phase_length);
+    for (std::uint64_t pid = 0; pid < cfg.num_procs; ++pid)
+    {
+        builder.add_io(pid, synthetic_filename(cfg, pid), "close", io_event_kind::delete_or_close,
+                io_operation_option_container(), 0, 0, close_ts, meta_duration);
+    }
+
+    return builder.finalize(cfg.num_procs);
+}
+
+} // namespace rabbitxx
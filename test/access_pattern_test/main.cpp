@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/access_pattern.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+TEST_CASE("[access_pattern]", "Streams are classified per process and file")
+{
+    io_graph_fixture fx;
+    // process 0: contiguous, metadata events are ignored
+    for (std::uint64_t i = 0; i < 4; ++i)
+    {
+        fx.data(0, "contiguous", io_event_kind::write, i * 100, 100, duration(10), fx.tick());
+    }
+    fx.metadata(0, "contiguous", io_event_kind::delete_or_close, duration(0), fx.tick());
+    // process 1: strided by 4 KiB
+    for (std::uint64_t i = 0; i < 4; ++i)
+    {
+        fx.data(1, "strided", io_event_kind::write, i * 4096, 512, duration(10), fx.tick());
+    }
+    // process 2: rows of 3 elements of a 2d sub-array
+    for (std::uint64_t row = 0; row < 3; ++row)
+    {
+        for (std::uint64_t col = 0; col < 3; ++col)
+        {
+            fx.data(2, "nested", io_event_kind::write, row * 10000 + col * 64, 32, duration(10), fx.tick());
+        }
+    }
+    // process 3: random
+    for (const auto off : { 900, 10, 5000, 70, 3000 })
+    {
+        fx.data(3, "random", io_event_kind::write, off, 8, duration(10), fx.tick());
+    }
+
+    const auto streams = classify_access_patterns(fx.graph, fx.set);
+    REQUIRE(streams.size() == 4);
+
+    SECTION("contiguous")
+    {
+        const auto& s = streams[0];
+        REQUIRE(s.proc_id == 0);
+        REQUIRE(s.pattern == access_pattern::contiguous);
+        REQUIRE(s.num_ops == 4);
+        REQUIRE(s.bytes == 400);
+        REQUIRE(s.contiguity == Approx(1.0));
+        REQUIRE(s.size_histogram.size() == 1);
+        REQUIRE(s.size_histogram.at(128) == 4);
+    }
+
+    SECTION("strided")
+    {
+        const auto& s = streams[1];
+        REQUIRE(s.pattern == access_pattern::strided);
+        REQUIRE(s.stride == 4096);
+        REQUIRE(s.contiguity == Approx(0.0));
+    }
+
+    SECTION("nested strided")
+    {
+        const auto& s = streams[2];
+        REQUIRE(s.pattern == access_pattern::nested_strided);
+        REQUIRE(s.stride == 64);
+        REQUIRE(s.outer_stride == 10000 - 2 * 64);
+        REQUIRE(s.inner_count == 3);
+    }
+
+    SECTION("random")
+    {
+        const auto& s = streams[3];
+        REQUIRE(s.pattern == access_pattern::random);
+        REQUIRE(s.min_size == 8);
+        REQUIRE(s.max_size == 8);
+    }
+}
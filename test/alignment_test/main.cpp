@@ -0,0 +1,71 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/alignment.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+namespace
+{
+
+alignment_config blocks_of(std::uint64_t block_size)
+{
+    alignment_config config;
+    config.layouts.default_layout = fs_layout { block_size, 1 };
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("[alignment] histograms", "Request sizes and offsets are binned per file")
+{
+    io_graph_fixture fx;
+    // process 0 writes full aligned blocks
+    fx.data(0, "data", io_event_kind::write, 0, 4096, duration(100), fx.tick());
+    fx.data(0, "data", io_event_kind::write, 4096, 4096, duration(100), fx.tick());
+    // process 1 writes small unaligned pieces
+    for (std::uint64_t i = 0; i < 4; ++i)
+    {
+        fx.data(1, "data", io_event_kind::write, 8192 + 8 + i * 100, 100, duration(50), fx.tick());
+    }
+
+    const auto files = analyze_alignment(fx.graph, fx.set, blocks_of(4096));
+    REQUIRE(files.size() == 1);
+    const auto& file = files[0];
+    REQUIRE(file.num_ops == 6);
+    REQUIRE(file.bytes == 8592);
+    REQUIRE(file.aligned_ops == 2);
+    REQUIRE(file.small_ops == 4);
+    REQUIRE(file.small_unaligned_ops == 4);
+    REQUIRE(file.size_histogram.at(4096) == 2);
+    REQUIRE(file.size_histogram.at(128) == 4);
+    REQUIRE(file.alignment_histogram.at(4096) == 2);
+    REQUIRE(file.alignment_histogram.at(8) == 1);
+    REQUIRE(file.flagged_procs == std::vector<std::uint64_t> { 1 });
+    REQUIRE(file.io_time == duration(400));
+}
+
+TEST_CASE("[alignment] aggregation", "Small requests are aggregated into aligned buffers")
+{
+    io_graph_fixture fx;
+    // duration = 10 + size / 10
+    for (std::uint64_t i = 0; i < 8; ++i)
+    {
+        fx.data(0, "data", io_event_kind::write, i * 100, 100, duration(20), fx.tick());
+    }
+    fx.data(1, "data", io_event_kind::write, 0, 1000, duration(110), fx.tick());
+
+    auto config = blocks_of(4096);
+    config.buffer_size = 1000;
+    const auto files = analyze_alignment(fx.graph, fx.set, config);
+    const auto& file = files[0];
+    REQUIRE(file.io_time == duration(270));
+    // one buffer of process 0 and one of process 1
+    REQUIRE(file.aggregated_ops == 2);
+    REQUIRE(file.saved_ops() == 7);
+    REQUIRE(file.aggregated_time == duration(2 * 10 + 1800 / 10));
+    REQUIRE(file.saved_time() == duration(70));
+}
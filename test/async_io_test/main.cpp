@@ -0,0 +1,160 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/graph.hpp>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator_async test: 4 locations, 2 phases of 4
+// non-blocking writes, completed in reverse order, each phase followed by a
+// non-blocking ring exchange of two messages, whose receives complete in
+// reverse order
+const std::uint64_t num_locations = 4;
+const std::uint64_t num_phases = 2;
+const std::uint64_t io_per_phase = 4;
+const std::uint64_t bytes_per_io = 4096;
+const otf2::chrono::duration tick(1);
+
+// vertices of one kind per process, in the order they completed
+std::map<std::uint64_t, std::vector<VertexDescriptor>> per_process(const IoGraph& graph,
+                                                                   vertex_kind kind)
+{
+    std::map<std::uint64_t, std::vector<VertexDescriptor>> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type == kind) {
+            result[graph[*it].id()].push_back(*it);
+        }
+    }
+    for (auto& kvp : result)
+    {
+        std::sort(kvp.second.begin(), kvp.second.end(),
+                [&graph](VertexDescriptor a, VertexDescriptor b) {
+                    return graph[a].timestamp() < graph[b].timestamp();
+                });
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("[async_io]", "Non-blocking operations pair their begin and completion by matching id")
+{
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(ASYNC_TRACE);
+    const auto writes = per_process(graph, vertex_kind::io_event);
+    REQUIRE(writes.size() == num_locations);
+
+    for (const auto& kvp : writes)
+    {
+        // the vertices of open and close are blocking
+        std::vector<io_event_property> ops;
+        for (const auto vd : kvp.second)
+        {
+            const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+            if (io_op.kind != io_event_kind::write) {
+                continue;
+            }
+            REQUIRE(io_op.async);
+            REQUIRE(graph[vd].duration.enter == io_op.async->begin);
+            REQUIRE(graph[vd].duration.leave == io_op.async->complete);
+            ops.push_back(io_op);
+        }
+        REQUIRE(ops.size() == num_phases * io_per_phase);
+        // in the order they began
+        std::sort(ops.begin(), ops.end(), [](const io_event_property& a, const io_event_property& b) {
+            return a.async->begin < b.async->begin;
+        });
+
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            const auto& async = *ops[i].async;
+            // the position is advanced at the begin
+            REQUIRE(ops[i].offset == (i + 1) * bytes_per_io);
+            REQUIRE(ops[i].response_size == bytes_per_io);
+            // the call returns right after the begin, the completion is the vertex timestamp
+            REQUIRE(async.issued == async.begin + tick);
+            REQUIRE(async.complete == ops[i].timestamp);
+            REQUIRE(*ops[i].iop_duration == async.complete - async.begin);
+            // the first operation of a phase is tested once before all complete
+            REQUIRE(async.num_tests == (i % io_per_phase == 0 ? 1 : 0));
+
+            const auto last = i - i % io_per_phase + io_per_phase - 1;
+            REQUIRE(async.complete > ops[last].async->issued);
+            if (i % io_per_phase != io_per_phase - 1)
+            {
+                // a later operation of the same phase completes right before
+                REQUIRE(ops[i + 1].async->complete + tick == async.complete);
+            }
+        }
+    }
+}
+
+TEST_CASE("[async_p2p]", "Non-blocking messages synchronize at the completion of their request")
+{
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(ASYNC_TRACE);
+    const auto syncs = per_process(graph, vertex_kind::sync_event);
+    const auto io = per_process(graph, vertex_kind::io_event);
+    REQUIRE(syncs.size() == num_locations);
+
+    // (process, remote process, tag) -> sync vertex
+    std::map<std::tuple<std::uint64_t, std::uint64_t, std::uint32_t>, VertexDescriptor> sends;
+    std::map<std::tuple<std::uint64_t, std::uint64_t, std::uint32_t>, VertexDescriptor> receives;
+    for (const auto& kvp : syncs)
+    {
+        const auto pid = kvp.first;
+        const auto right = (pid + 1) % num_locations;
+        const auto left = (pid + num_locations - 1) % num_locations;
+        REQUIRE(kvp.second.size() == num_phases * 4);
+
+        for (std::uint64_t phase = 0; phase < num_phases; ++phase)
+        {
+            // the receives complete in reverse order, then the sends in order
+            const std::vector<std::pair<std::uint64_t, std::uint32_t>> expected {
+                { left, 2 * phase + 1 }, { left, 2 * phase }, { right, 2 * phase }, { right, 2 * phase + 1 }
+            };
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                const auto vd = kvp.second[phase * 4 + i];
+                const auto& sync = boost::get<sync_event_property>(graph[vd].property);
+                REQUIRE(sync.comm_kind == sync_event_kind::p2p);
+                // placed where the request completed, not where it was posted
+                REQUIRE(sync.region_name == "MPI_Waitall");
+                const auto& p2p = boost::get<peer2peer>(sync.op_data);
+                REQUIRE(p2p.request_id());
+                REQUIRE(p2p.remote_process() == expected[i].first);
+                REQUIRE(p2p.msg_tag() == expected[i].second);
+                // after all I/O of the phase completed, the open vertex comes first
+                const auto last_io = io.at(pid)[(phase + 1) * io_per_phase];
+                REQUIRE(sync.timestamp > graph[last_io].timestamp());
+
+                auto& slot = i < 2 ? receives : sends;
+                slot[std::make_tuple(pid, p2p.remote_process(), p2p.msg_tag())] = vd;
+            }
+        }
+    }
+
+    // every receive is matched with the send of the same tag
+    REQUIRE(receives.size() == sends.size());
+    for (const auto& kvp : receives)
+    {
+        std::uint64_t pid, sender;
+        std::uint32_t tag;
+        std::tie(pid, sender, tag) = kvp.first;
+        const auto send = sends.at(std::make_tuple(sender, pid, tag));
+        const auto recv = kvp.second;
+        const auto& send_evt = boost::get<sync_event_property>(graph[send].property);
+        const auto& recv_evt = boost::get<sync_event_property>(graph[recv].property);
+        REQUIRE((send_evt.root_event == recv || recv_evt.root_event == send));
+        REQUIRE((boost::edge(send, recv, *graph.get()).second
+                 || boost::edge(recv, send, *graph.get()).second));
+    }
+}
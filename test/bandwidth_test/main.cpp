@@ -0,0 +1,54 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/bandwidth.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+namespace
+{
+
+busy_interval span(std::int64_t begin, std::int64_t end)
+{
+    return busy_interval { at(begin), at(end) };
+}
+
+} // namespace
+
+TEST_CASE("[bandwidth] union", "Overlapping intervals are counted once")
+{
+    REQUIRE(busy_time({}) == duration(0));
+    REQUIRE(busy_time({ span(10, 20) }) == duration(10));
+    // nested, overlapping, touching and disjoint intervals
+    REQUIRE(busy_time({ span(50, 60), span(0, 10), span(2, 5), span(5, 15), span(15, 20), span(55, 70) })
+            == duration(40));
+}
+
+TEST_CASE("[bandwidth] set", "Bytes over busy time per set, file, file system and process")
+{
+    io_graph_fixture fx;
+    fx.properties().file_to_fs["a"] = "lustre";
+    // two processes writing to a concurrently, process 1 also writes b later
+    fx.data(0, "a", io_event_kind::write, 0, 1000, duration(100), at(100));
+    fx.data(1, "a", io_event_kind::write, 0, 1000, duration(100), at(150));
+    fx.data(1, "b", io_event_kind::write, 0, 500, duration(100), at(400));
+
+    const auto bw = analyze_bandwidth(fx.graph, fx.set);
+    REQUIRE(bw.total.bytes == 2500);
+    REQUIRE(bw.total.busy_time == duration(250));
+    REQUIRE(bw.per_file.at("a").busy_time == duration(150));
+    REQUIRE(bw.per_file.at("b").bytes == 500);
+    REQUIRE(bw.per_fs.size() == 1);
+    REQUIRE(bw.per_fs.at("lustre").bytes == 2000);
+    REQUIRE(bw.per_process.num_procs == 2);
+
+    const auto secs = [](std::int64_t ticks) {
+        return std::chrono::duration<double>(duration(ticks)).count();
+    };
+    REQUIRE(bw.per_process.min == Approx(1500 / secs(200)));
+    REQUIRE(bw.per_process.max == Approx(1000 / secs(100)));
+    REQUIRE(bw.per_process.median == Approx((bw.per_process.min + bw.per_process.max) / 2));
+}
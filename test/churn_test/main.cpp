@@ -0,0 +1,60 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/churn.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+TEST_CASE("[churn]", "Open/close cycles per file and process")
+{
+    io_graph_fixture fx;
+    auto& info = fx.properties();
+    info.io_time = duration(100);
+    info.io_metadata_time = duration(300);
+
+    // process 0 reopens "loop" three times, with a nested dup in the first cycle
+    for (int i = 0; i < 3; ++i)
+    {
+        fx.metadata(0, "loop", io_event_kind::create, duration(20), fx.tick());
+        if (i == 0)
+        {
+            fx.metadata(0, "loop", io_event_kind::dup, duration(5), fx.tick());
+            fx.metadata(0, "loop", io_event_kind::delete_or_close, duration(5), fx.tick());
+        }
+        fx.data(0, "loop", io_event_kind::write, 0, 10, duration(10), fx.tick());
+        fx.metadata(0, "loop", io_event_kind::delete_or_close, duration(20), fx.tick());
+    }
+    // process 1 closes a file opened before and leaves another one open
+    fx.metadata(1, "loop", io_event_kind::delete_or_close, duration(10), fx.tick());
+    fx.metadata(1, "log", io_event_kind::create, duration(10), fx.tick());
+    fx.data(1, "log", io_event_kind::write, 0, 1000, duration(30), fx.tick());
+
+    const auto churn = analyze_churn(fx.graph, fx.set);
+    REQUIRE(churn.total.cycles == 3);
+    REQUIRE(churn.total.unmatched_closes == 1);
+    REQUIRE(churn.total.open_cycles == 1);
+    REQUIRE(churn.total.bytes == 1030);
+    REQUIRE(churn.total.metadata_time == duration(150));
+    REQUIRE(churn.total.data_time == duration(60));
+    REQUIRE(churn.app_metadata_fraction == Approx(0.75));
+    REQUIRE(churn.share_of_app_metadata_time == Approx(0.5));
+
+    REQUIRE(churn.files.size() == 2);
+    const auto& loop = churn.files[0];
+    REQUIRE(loop.filename == "loop");
+    REQUIRE(loop.counts.cycles == 3);
+    REQUIRE(loop.counts.bytes_per_cycle() == Approx(10.0));
+    REQUIRE(loop.counts.metadata_fraction() == Approx(140.0 / 170.0));
+
+    REQUIRE(churn.procs.size() == 2);
+    REQUIRE(churn.procs[0].counts.cycles == 3);
+    REQUIRE(churn.procs[1].counts.unmatched_closes == 1);
+    REQUIRE(churn.procs[1].counts.open_cycles == 1);
+    REQUIRE(churn.procs[1].counts.bytes_per_cycle() == Approx(0.0));
+
+    const auto app = analyze_churn(fx.graph);
+    REQUIRE(app.total.cycles == 3);
+}
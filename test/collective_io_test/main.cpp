@@ -0,0 +1,242 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
+#include <set>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator_collective test: 8 locations in 2
+// sub-communicators {0, 2, 4, 6} and {1, 3, 5, 7}, 2 phases of 4 collective
+// writes separated by barriers over all locations
+const std::uint64_t num_locations = 8;
+const std::uint64_t num_groups = 2;
+const std::uint64_t num_phases = 2;
+const std::uint64_t io_per_phase = 4;
+const std::uint64_t bytes_per_io = 4096;
+
+IoGraph build_graph()
+{
+    graph::builder_config config;
+    config.aggregate_collective_io = true;
+    // collective operations are never folded
+    config.compact_io = true;
+    return make_graph<graph::OTF2_Io_Graph_Builder>(COLLECTIVE_TRACE, config);
+}
+
+std::vector<VertexDescriptor> writes(const IoGraph& graph)
+{
+    std::vector<VertexDescriptor> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::io_event) {
+            continue;
+        }
+        if (boost::get<io_event_property>(graph[*it].property).kind == io_event_kind::write) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+std::vector<VertexDescriptor> call_vertices(const IoGraph& graph)
+{
+    std::vector<VertexDescriptor> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type == vertex_kind::collective_io) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+bool contains(const set_t<VertexDescriptor>& set, VertexDescriptor vd)
+{
+    return std::find(set.begin(), set.end(), vd) != set.end();
+}
+
+} // namespace
+
+TEST_CASE("[collective_io_vertices]", "Every process keeps its own vertex")
+{
+    const auto graph = build_graph();
+    const auto io = writes(graph);
+    REQUIRE(io.size() == num_locations * num_phases * io_per_phase);
+
+    std::map<std::uint64_t, std::uint64_t> per_proc;
+    for (const auto vd : io)
+    {
+        const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+        REQUIRE(io_op.is_collective());
+        ++per_proc[io_op.proc_id];
+    }
+    REQUIRE(per_proc.size() == num_locations);
+    for (const auto& kvp : per_proc)
+    {
+        REQUIRE(kvp.second == num_phases * io_per_phase);
+    }
+}
+
+TEST_CASE("[collective_io_calls]", "One vertex per call, matched per sub-communicator")
+{
+    const auto graph = build_graph();
+    const auto calls = call_vertices(graph);
+    REQUIRE(calls.size() == num_groups * num_phases * io_per_phase);
+
+    for (const auto call_vd : calls)
+    {
+        const auto& call = boost::get<collective_io_property>(graph[call_vd].property);
+        REQUIRE(call.ranges.num_procs() == num_locations / num_groups);
+        REQUIRE(call.bytes == num_locations / num_groups * bytes_per_io);
+        REQUIRE(call.begin <= call.end);
+        REQUIRE(graph[call_vd].id() == std::numeric_limits<std::uint64_t>::max());
+
+        std::set<std::uint64_t> members;
+        const auto ops = boost::adjacent_vertices(call_vd, *graph.get());
+        for (auto it = ops.first; it != ops.second; ++it)
+        {
+            REQUIRE(graph[*it].type == vertex_kind::io_event);
+            const auto& io_op = boost::get<io_event_property>(graph[*it].property);
+            REQUIRE(io_op.collective_event == call_vd);
+            members.insert(io_op.proc_id);
+        }
+        REQUIRE(members.size() == num_locations / num_groups);
+        // all processes belong to the same group
+        const auto group = *members.begin() % num_groups;
+        for (const auto proc : members)
+        {
+            REQUIRE(proc % num_groups == group);
+        }
+    }
+}
+
+TEST_CASE("[collective_io_sets]", "Concurrent I/O sets contain whole collective calls")
+{
+    auto graph = build_graph();
+    const auto cio_sets = find_cio_sets(graph);
+
+    // the sets of the phases hold the writes of all processes, the opening
+    // and closing of the handles may form sets on their own
+    std::size_t write_sets = 0;
+    for (const auto& set : cio_sets)
+    {
+        std::set<std::uint64_t> members;
+        for (const auto vd : set)
+        {
+            // the call vertices belong to no process and to no set
+            REQUIRE(graph[vd].type == vertex_kind::io_event);
+            const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+            if (io_op.kind == io_event_kind::write) {
+                members.insert(io_op.proc_id);
+            }
+        }
+        if (!members.empty()) {
+            ++write_sets;
+            REQUIRE(members.size() == num_locations);
+        }
+    }
+    REQUIRE(write_sets == num_phases);
+
+    for (const auto call_vd : call_vertices(graph))
+    {
+        const auto ops = boost::adjacent_vertices(call_vd, *graph.get());
+        const auto set = std::find_if(cio_sets.begin(), cio_sets.end(),
+                [&ops](const set_t<VertexDescriptor>& s) { return contains(s, *ops.first); });
+        REQUIRE(set != cio_sets.end());
+        for (auto it = ops.first; it != ops.second; ++it)
+        {
+            REQUIRE(contains(*set, *it));
+        }
+    }
+}
+
+TEST_CASE("[collective_io_matching]", "The n-th operation of every member forms the n-th call")
+{
+    // processes 0..3 write two blocks each with collective buffering on
+    // communicator 1, processes 0 and 2 one more block on communicator 2
+    const std::uint64_t block = 100;
+    const std::map<std::uint64_t, std::vector<std::uint64_t>> members {
+        { 1, { 0, 1, 2, 3 } }, { 2, { 0, 2 } } };
+    IoGraph graph;
+    std::map<std::uint64_t, std::deque<graph::collective_io_candidate>> collective_ios;
+    auto write = [&graph, &collective_ios](std::uint64_t pid, std::uint64_t comm,
+                                            std::uint64_t begin, std::uint64_t size) {
+        const auto leave = otf2::chrono::time_point(otf2::chrono::duration(begin + size));
+        const auto vd = graph.add_vertex(otf2_trace_event(io_event_property(pid, "shared", "write",
+                "MPI-IO", size, size, begin + size, io_operation_option_container(),
+                io_event_kind::write, otf2::chrono::duration(size), leave)));
+        collective_ios[pid].push_back(graph::collective_io_candidate { vd, comm });
+        return vd;
+    };
+    std::vector<VertexDescriptor> ops;
+    for (std::uint64_t call = 0; call < 2; ++call)
+    {
+        for (std::uint64_t pid = 0; pid < 4; ++pid)
+        {
+            ops.push_back(write(pid, 1, (call * 4 + pid) * block, block));
+        }
+    }
+    ops.push_back(write(2, 2, 1000, block));
+    ops.push_back(write(0, 2, 2000, block));
+
+    REQUIRE(graph::match_collective_io(graph, collective_ios, members, false));
+    const auto calls = call_vertices(graph);
+    REQUIRE(calls.size() == 3);
+    for (const auto& kvp : collective_ios)
+    {
+        REQUIRE(kvp.second.empty());
+    }
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        const auto& call = boost::get<collective_io_property>(graph[calls[i]].property);
+        // consecutive processes write consecutive blocks, a single run
+        REQUIRE(call.ranges.runs.size() == 1);
+        REQUIRE(call.ranges.runs[0].first_proc == 0);
+        REQUIRE(call.ranges.runs[0].num_procs == 4);
+        REQUIRE(call.ranges.runs[0].offset == i * 4 * block);
+        REQUIRE(call.bytes == 4 * block);
+        REQUIRE(graph.out_degree(calls[i]) == 4);
+        for (std::size_t pid = 0; pid < 4; ++pid)
+        {
+            const auto& io_op = boost::get<io_event_property>(graph[ops[i * 4 + pid]].property);
+            REQUIRE(io_op.collective_event == calls[i]);
+        }
+    }
+    const auto& sub = boost::get<collective_io_property>(graph[calls[2]].property);
+    REQUIRE(sub.ranges.num_procs() == 2);
+    REQUIRE(sub.ranges.runs.size() == 2);
+    REQUIRE(sub.bytes == 2 * block);
+    REQUIRE(sub.begin == otf2::chrono::time_point(otf2::chrono::duration(1000)));
+    REQUIRE(sub.end == otf2::chrono::time_point(otf2::chrono::duration(2100)));
+}
+
+TEST_CASE("[collective_io_partial]", "A missing member fails unless the trace is partial")
+{
+    const std::map<std::uint64_t, std::vector<std::uint64_t>> members { { 1, { 0, 1 } } };
+    IoGraph graph;
+    std::map<std::uint64_t, std::deque<graph::collective_io_candidate>> collective_ios;
+    const auto vd = graph.add_vertex(otf2_trace_event(io_event_property(0, "shared", "write",
+            "MPI-IO", 8, 8, 8, io_operation_option_container(), io_event_kind::write,
+            otf2::chrono::duration(1), otf2::chrono::time_point(otf2::chrono::duration(1)))));
+    collective_ios[0].push_back(graph::collective_io_candidate { vd, 1 });
+
+    auto unmatched = collective_ios;
+    REQUIRE(!graph::match_collective_io(graph, unmatched, members, false));
+    REQUIRE(graph::match_collective_io(graph, collective_ios, members, true));
+    const auto calls = call_vertices(graph);
+    REQUIRE(calls.size() == 1);
+    REQUIRE(boost::get<io_event_property>(graph[vd].property).collective_event == calls.front());
+}
@@ -0,0 +1,85 @@
+#ifndef RABBITXX_TEST_IO_GRAPH_FIXTURE_HPP
+#define RABBITXX_TEST_IO_GRAPH_FIXTURE_HPP
+
+#include <rabbitxx/cio_types.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace rabbitxx { namespace test {
+
+using otf2::chrono::duration;
+using otf2::chrono::time_point;
+
+inline time_point at(std::int64_t ticks)
+{
+    return time_point(duration(ticks));
+}
+
+/**
+ * @brief A graph of I/O vertices built by hand and a set holding all of them,
+ * the input of the analyses.
+ *
+ * Like the builder, the vertices store the file position after the operation
+ * as offset and the completion as timestamp.
+ */
+struct io_graph_fixture
+{
+    /**
+     * @brief Add a read or write of `size` bytes from `begin`, which takes
+     * `dur` and completes at `leave`.
+     */
+    VertexDescriptor data(std::uint64_t pid, const std::string& file, io_event_kind kind,
+                        std::uint64_t begin, std::uint64_t size, duration dur, time_point leave)
+    {
+        const auto write = kind == io_event_kind::write;
+        const auto mode = write ? otf2::common::io_operation_mode_type::write
+                                : otf2::common::io_operation_mode_type::read;
+        const auto vt = io_event_property(pid, file, write ? "write" : "read", "POSIX",
+                size, size, begin + size, io_operation_option_container(mode), kind,
+                boost::optional<duration>(dur), leave);
+        return add(vt, dur, leave);
+    }
+
+    /**
+     * @brief Add a metadata operation, e.g. create or close, whose region
+     * takes `dur` and is left at `leave`.
+     */
+    VertexDescriptor metadata(std::uint64_t pid, const std::string& file, io_event_kind kind,
+                            duration dur, time_point leave)
+    {
+        const auto vt = io_event_property(pid, file, "metadata", "POSIX", 0, 0, 0,
+                io_operation_option_container(), kind, boost::none, leave);
+        return add(vt, dur, leave);
+    }
+
+    // distinct timestamps for tests in which the time does not matter
+    time_point tick()
+    {
+        return at(ticks_++);
+    }
+
+    app_info& properties()
+    {
+        return graph.get()->operator[](boost::graph_bundle);
+    }
+
+    IoGraph graph;
+    set_t<VertexDescriptor> set;
+
+private:
+    VertexDescriptor add(const io_event_property& vt, duration dur, time_point leave)
+    {
+        const auto vd = graph.add_vertex(otf2_trace_event(vt));
+        graph[vd].duration = { dur, leave - dur, leave };
+        set.insert(vd);
+        return vd;
+    }
+
+    std::int64_t ticks_ = 1;
+};
+
+}} // namespace rabbitxx::test
+
+#endif // RABBITXX_TEST_IO_GRAPH_FIXTURE_HPP
@@ -0,0 +1,120 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator test: 8 locations, 3 phases of 4 writes to
+// a shared file, separated by barriers
+const std::uint64_t num_locations = 8;
+const std::uint64_t num_phases = 3;
+const std::uint64_t io_per_phase = 4;
+const std::uint64_t bytes_per_io = 4096;
+
+IoGraph build_graph(bool compact_io)
+{
+    graph::builder_config config;
+    config.compact_io = compact_io;
+    return make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+}
+
+// writes per process, in the order of their file position
+std::map<std::uint64_t, std::vector<io_event_property>> writes(const IoGraph& graph)
+{
+    std::map<std::uint64_t, std::vector<io_event_property>> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::io_event) {
+            continue;
+        }
+        const auto& io_op = boost::get<io_event_property>(graph[*it].property);
+        if (io_op.kind == io_event_kind::write) {
+            result[io_op.proc_id].push_back(io_op);
+        }
+    }
+    for (auto& kvp : result)
+    {
+        std::sort(kvp.second.begin(), kvp.second.end(),
+                [](const io_event_property& a, const io_event_property& b) {
+                    return a.offset < b.offset;
+                });
+    }
+    return result;
+}
+
+// (process, number of vertices, bytes written) of each set, in a canonical order
+std::vector<std::map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t>>>
+summarize_sets(IoGraph& graph)
+{
+    std::vector<std::map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t>>> result;
+    for (const auto& set : find_cio_sets(graph))
+    {
+        std::map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t>> summary;
+        for (const auto vd : set)
+        {
+            const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+            auto& entry = summary[io_op.proc_id];
+            // a folded vertex counts as the operations it holds
+            entry.first += io_op.range ? io_op.range->count : 1;
+            if (io_op.kind == io_event_kind::write) {
+                entry.second += io_op.response_size;
+            }
+        }
+        result.push_back(summary);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("[compaction]", "The writes of a phase fold into one vertex")
+{
+    const auto graph = build_graph(true);
+    const auto per_process = writes(graph);
+    REQUIRE(per_process.size() == num_locations);
+
+    const auto phase_bytes = io_per_phase * bytes_per_io;
+    for (const auto& kvp : per_process)
+    {
+        // the barrier ends the run of each phase
+        REQUIRE(kvp.second.size() == num_phases);
+        for (std::uint64_t phase = 0; phase < num_phases; ++phase)
+        {
+            const auto& io_op = kvp.second[phase];
+            REQUIRE(io_op.range);
+            const auto& range = *io_op.range;
+            REQUIRE(range.count == io_per_phase);
+            REQUIRE(range.first_offset == phase * phase_bytes);
+            REQUIRE(range.last_offset == (phase + 1) * phase_bytes);
+            REQUIRE(range.total_bytes == phase_bytes);
+            REQUIRE(io_op.offset == range.last_offset);
+            REQUIRE(io_op.response_size == phase_bytes);
+            REQUIRE(range.last_timestamp == io_op.timestamp);
+            REQUIRE(range.first_timestamp < range.last_timestamp);
+        }
+    }
+}
+
+TEST_CASE("[compaction_sets]", "Compaction keeps the sets of concurrent I/O")
+{
+    auto compacted = build_graph(true);
+    auto full = build_graph(false);
+    REQUIRE(compacted.num_vertices() < full.num_vertices());
+
+    const auto compacted_sets = summarize_sets(compacted);
+    const auto full_sets = summarize_sets(full);
+    // one set per phase, plus the set after the last barrier
+    REQUIRE(full_sets.size() == num_phases + 1);
+    REQUIRE(compacted_sets == full_sets);
+}
@@ -0,0 +1,39 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/concurrency.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+TEST_CASE("[concurrency]", "Concurrent operations are binned over time")
+{
+    io_graph_fixture fx;
+    fx.properties().file_to_fs["a"] = "lustre";
+    fx.data(0, "a", io_event_kind::write, 0, 1000, duration(100), at(100));
+    fx.data(1, "b", io_event_kind::write, 0, 500, duration(100), at(150));
+    fx.data(1, "b", io_event_kind::write, 0, 100, duration(0), at(150));
+
+    const auto profiles = concurrency_over_time(fx.graph, duration(100));
+    REQUIRE(profiles.size() == 2);
+    REQUIRE(profiles[1].file_system == "lustre");
+
+    const auto& all = profiles[0];
+    REQUIRE(all.start == time_point(duration(0)));
+    REQUIRE(all.bins.size() == 2);
+    REQUIRE(all.bins[0].mean_ops == Approx(1.5));
+    REQUIRE(all.bins[0].max_ops == 2);
+    REQUIRE(all.bins[0].mean_procs == Approx(1.5));
+    REQUIRE(all.bins[0].max_files == 2);
+    REQUIRE(all.bins[0].bytes == Approx(1250.0));
+    REQUIRE(all.bins[1].mean_ops == Approx(0.5));
+    REQUIRE(all.bins[1].max_procs == 1);
+    REQUIRE(all.bins[1].bytes == Approx(350.0));
+
+    const auto& lustre = profiles[1];
+    REQUIRE(lustre.bins[0].mean_ops == Approx(1.0));
+    REQUIRE(lustre.bins[0].bytes == Approx(1000.0));
+    REQUIRE(lustre.bins[1].max_ops == 0);
+}
@@ -48,7 +48,7 @@ void print_info_as(const rabbitxx::app_info& info)
 
 void print_graph_properties(const rabbitxx::IoGraph& graph)
 {
-    auto info = graph.graph_properties();
+    const auto& info = graph.graph_properties();
     print_info_as(info);
 }
 
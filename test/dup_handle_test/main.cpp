@@ -0,0 +1,65 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/graph.hpp>
+
+#include <map>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator_dup test: 2 locations, 2 phases of 6 writes,
+// which cycle through the handle, its duplicate and a second handle of the
+// same file and name
+const std::uint64_t num_locations = 2;
+const std::uint64_t num_phases = 2;
+const std::uint64_t io_per_phase = 6;
+const std::uint64_t bytes_per_io = 4096;
+
+// offsets of the writes per process, in the order they were written
+std::map<std::uint64_t, std::vector<std::uint64_t>> write_offsets(const IoGraph& graph)
+{
+    std::map<std::uint64_t, std::vector<std::uint64_t>> offsets;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::io_event) {
+            continue;
+        }
+        const auto& io_op = boost::get<io_event_property>(graph[*it].property);
+        if (io_op.kind == io_event_kind::write) {
+            offsets[io_op.proc_id].push_back(io_op.offset);
+        }
+    }
+    return offsets;
+}
+
+} // namespace
+
+TEST_CASE("[dup_handle]", "Duplicated handles share one position, other handles keep their own")
+{
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(DUP_TRACE);
+    const auto offsets = write_offsets(graph);
+    REQUIRE(offsets.size() == num_locations);
+
+    for (const auto& kvp : offsets)
+    {
+        const auto& proc_offsets = kvp.second;
+        REQUIRE(proc_offsets.size() == num_phases * io_per_phase);
+        // the handle and its duplicate advance one position, the second
+        // handle has the same name but a position of its own
+        std::uint64_t shared_position = 0;
+        std::uint64_t second_position = 0;
+        for (std::size_t i = 0; i < proc_offsets.size(); ++i)
+        {
+            auto& position = i % 3 == 2 ? second_position : shared_position;
+            position += bytes_per_io;
+            // the offset is the position after the write
+            REQUIRE(proc_offsets[i] == position);
+        }
+        REQUIRE(shared_position == 2 * second_position);
+    }
+}
@@ -0,0 +1,69 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/false_sharing.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+namespace
+{
+
+stripe_config blocks_of(std::uint64_t block_size, std::uint64_t stripe_count)
+{
+    stripe_config config;
+    config.default_layout = fs_layout { block_size, stripe_count };
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("[false_sharing] aligned", "Aligned writes do not share units")
+{
+    io_graph_fixture fx;
+    for (std::uint64_t pid = 0; pid < 4; ++pid)
+    {
+        fx.data(pid, "shared", io_event_kind::write, pid * 100, 100, duration(10), at(pid));
+    }
+    const auto files = analyze_false_sharing(fx.graph, fx.set, blocks_of(100, 2));
+    REQUIRE(files.size() == 1);
+    REQUIRE(files[0].num_procs == 4);
+    REQUIRE(files[0].units_touched == 4);
+    REQUIRE(files[0].shared_units == 0);
+    REQUIRE(files[0].max_sharers == 1);
+    REQUIRE(files[0].max_lock_transfers == 0);
+}
+
+TEST_CASE("[false_sharing] disjoint", "Disjoint writes within one unit conflict")
+{
+    io_graph_fixture fx;
+    // 4 processes write 64 bytes each, two per 128 byte unit
+    for (std::uint64_t pid = 0; pid < 4; ++pid)
+    {
+        fx.data(pid, "shared", io_event_kind::write, pid * 64, 64, duration(10), at(pid));
+    }
+    // a second write of process 0 to its first unit
+    fx.data(0, "shared", io_event_kind::write, 0, 64, duration(10), at(0));
+    const auto files = analyze_false_sharing(fx.graph, fx.set, blocks_of(128, 4));
+    REQUIRE(files[0].units_touched == 2);
+    REQUIRE(files[0].shared_units == 2);
+    REQUIRE(files[0].conflicting_units == 2);
+    REQUIRE(files[0].max_sharers == 2);
+    REQUIRE(files[0].contended_servers == 2);
+    REQUIRE(files[0].min_lock_transfers == 2);
+    REQUIRE(files[0].max_lock_transfers == 3);
+}
+
+TEST_CASE("[false_sharing] reads", "Shared reads do not conflict")
+{
+    io_graph_fixture fx;
+    fx.data(0, "shared", io_event_kind::read, 0, 1000, duration(10), at(0));
+    fx.data(1, "shared", io_event_kind::read, 500, 1000, duration(10), at(1));
+    const auto files = analyze_false_sharing(fx.graph, fx.set, blocks_of(100, 1));
+    REQUIRE(files[0].units_touched == 15);
+    REQUIRE(files[0].shared_units == 5);
+    REQUIRE(files[0].conflicting_units == 0);
+    REQUIRE(files[0].contended_servers == 0);
+}
@@ -0,0 +1,55 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/filter.hpp>
+
+TEST_CASE("[path_trie]", "Match path prefixes")
+{
+    rabbitxx::path_trie trie;
+    REQUIRE(trie.empty());
+    REQUIRE(!trie.matches_prefix("/proc/self/maps"));
+
+    trie.insert("/proc");
+    trie.insert("/sys");
+    trie.insert("/software");
+    trie.insert("/sw");
+    trie.insert("/proc");
+    REQUIRE(trie.size() == 4);
+
+    REQUIRE(trie.matches_prefix("/proc/self/maps"));
+    REQUIRE(trie.matches_prefix("/sys/devices"));
+    REQUIRE(trie.matches_prefix("/sw/installed/lib.so"));
+    REQUIRE(trie.matches_prefix("/software/lib.so"));
+    REQUIRE(!trie.matches_prefix("/scratch/out.dat"));
+    REQUIRE(!trie.matches_prefix("/pro"));
+    REQUIRE(!trie.matches_prefix(""));
+}
+
+TEST_CASE("[filter_spec]", "Default and pseudo file filter")
+{
+    rabbitxx::filter_spec def;
+    REQUIRE(def.is_paradigm_filtered("MPI-IO"));
+    REQUIRE(!def.is_paradigm_filtered("POSIX"));
+    REQUIRE(!def.is_path_filtered("/proc/cpuinfo"));
+    REQUIRE(!def.is_region_filtered("write"));
+
+    auto pseudo = rabbitxx::filter_spec::pseudo_files();
+    REQUIRE(pseudo.is_paradigm_filtered("MPI-IO"));
+    REQUIRE(pseudo.is_path_filtered("/proc/cpuinfo"));
+    REQUIRE(pseudo.is_path_filtered("/dev/shm/x"));
+    REQUIRE(pseudo.is_path_filtered("STDOUT_FILENO"));
+    REQUIRE(!pseudo.is_path_filtered("/lustre/scratch/file"));
+
+    SECTION("allowed paradigms and regions")
+    {
+        rabbitxx::filter_spec spec;
+        spec.allowed_paradigms = { "POSIX" };
+        spec.included_regions = { "write", "pwrite" };
+        spec.excluded_regions = { "pwrite" };
+        REQUIRE(!spec.is_paradigm_filtered("POSIX"));
+        REQUIRE(spec.is_paradigm_filtered("ISOC"));
+        REQUIRE(!spec.is_region_filtered("write"));
+        REQUIRE(spec.is_region_filtered("pwrite"));
+        REQUIRE(spec.is_region_filtered("read"));
+    }
+}
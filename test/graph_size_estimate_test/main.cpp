@@ -0,0 +1,84 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/graph.hpp>
+#include <rabbitxx/graph/builder/graph_size_estimate.hpp>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator test: 8 locations, 3 phases of 4 writes to
+// a shared file, separated by barriers. Every event takes one nanosecond
+// tick, the phases start at tick 4 and take 20 ticks each.
+const std::uint64_t num_locations = 8;
+const std::int64_t first_phase = 4;
+const std::int64_t ticks_per_phase = 20;
+
+otf2::chrono::time_point at(std::int64_t ticks)
+{
+    return otf2::chrono::time_point(otf2::chrono::duration(ticks));
+}
+
+// estimate and build the graph with the same configuration
+void require_exact_count(graph::builder_config config)
+{
+    config.presize = graph::presize_mode::count;
+    const auto estimate = graph::estimate_graph_size(SYNTHETIC_TRACE, config);
+    REQUIRE(estimate.mode == graph::presize_mode::count);
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+    REQUIRE(estimate.locations.size() == graph.graph_properties().num_locations);
+    REQUIRE(estimate.num_vertices() == graph.num_vertices());
+}
+
+} // namespace
+
+TEST_CASE("[graph_size_estimate]", "The count estimate matches the vertices the builder creates")
+{
+    SECTION("Whole trace")
+    {
+        require_exact_count(graph::builder_config());
+    }
+
+    SECTION("Time window")
+    {
+        graph::builder_config config;
+        config.window_begin = at(first_phase + ticks_per_phase + 1);
+        config.window_end = at(first_phase + 2 * ticks_per_phase);
+        require_exact_count(config);
+    }
+
+    SECTION("Location subset")
+    {
+        graph::builder_config config;
+        config.locations = { 2, 5, 7 };
+        require_exact_count(config);
+    }
+}
+
+TEST_CASE("[graph_size_estimate_bounds]", "The estimates bound the graph from above")
+{
+    graph::builder_config config;
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+
+    // the event counts of the location definitions
+    config.presize = graph::presize_mode::definitions;
+    const auto from_definitions = graph::estimate_graph_size(SYNTHETIC_TRACE, config);
+    REQUIRE(from_definitions.locations.size() == num_locations);
+    REQUIRE(from_definitions.num_vertices() >= graph.num_vertices());
+
+    // folded runs of writes are counted as single operations
+    config.compact_io = true;
+    config.presize = graph::presize_mode::none;
+    const auto compacted = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+    config.presize = graph::presize_mode::count;
+    const auto counted = graph::estimate_graph_size(SYNTHETIC_TRACE, config);
+    REQUIRE(counted.num_vertices() == graph.num_vertices());
+    REQUIRE(compacted.num_vertices() < counted.num_vertices());
+
+    // building with a reserved graph does not change it
+    const auto presized = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+    REQUIRE(presized.num_vertices() == compacted.num_vertices());
+    REQUIRE(presized.num_edges() == compacted.num_edges());
+}
@@ -0,0 +1,83 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/imbalance.hpp>
+
+#include <numeric>
+#include <vector>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+namespace
+{
+
+// closing barrier, process `i` enters it at `enters[i]`, all leave at `leave`.
+// Like the builder, the barrier of process 0 is the root, which is linked to
+// the barriers of the other processes.
+void close_set(io_graph_fixture& fx, const std::vector<std::int64_t>& enters, std::int64_t leave)
+{
+    std::vector<std::uint64_t> members(enters.size());
+    std::iota(members.begin(), members.end(), 0);
+    auto root = IoGraph::null_vertex();
+    for (std::uint64_t pid = 0; pid < enters.size(); ++pid)
+    {
+        const auto vt = sync_event_property(pid, "MPI_Barrier", collective(members), at(leave));
+        const auto vd = fx.graph.add_vertex(otf2_trace_event(vt));
+        if (root == IoGraph::null_vertex()) {
+            root = vd;
+        }
+        else {
+            fx.graph.add_edge(root, vd);
+        }
+        boost::get<sync_event_property>(fx.graph[vd].property).root_event = root;
+        fx.graph[vd].duration = { duration(leave - enters[pid]), at(enters[pid]), at(leave) };
+    }
+    fx.set.set_end_event(root);
+}
+
+} // namespace
+
+TEST_CASE("[imbalance] set", "Per-process load and straggler waits of one set")
+{
+    io_graph_fixture fx;
+    fx.data(0, "a", io_event_kind::write, 0, 100, duration(10), at(10));
+    fx.data(1, "a", io_event_kind::write, 0, 100, duration(10), at(10));
+    fx.data(2, "b", io_event_kind::write, 0, 400, duration(40), at(40));
+    // process 3 has no I/O in the set, its wait is not counted
+    close_set(fx, { 10, 10, 40, 0 }, 45);
+
+    const auto res = analyze_imbalance(fx.graph, fx.set, 2);
+    REQUIRE(res.procs.size() == 3);
+    REQUIRE(res.procs[2].io_time == duration(40));
+    REQUIRE(res.procs[2].bytes == 400);
+    REQUIRE(res.max_over_mean == Approx(2.0));
+    REQUIRE(res.coefficient_of_variation == Approx(std::sqrt(200.0) / 20.0));
+    REQUIRE(res.slowest_procs == std::vector<std::uint64_t> { 2, 0 });
+    REQUIRE(res.slowest_files == std::vector<std::string> { "b", "a" });
+    REQUIRE(res.files[0].bytes == 400);
+    REQUIRE(res.procs[0].straggler_wait == duration(30));
+    REQUIRE(res.procs[2].straggler_wait == duration(0));
+    REQUIRE(res.straggler_wait == duration(60));
+    // every process waits until the straggler 2 left the barrier
+    REQUIRE(res.end_sync_time == duration(35 + 35 + 5));
+    REQUIRE(res.end_sync_straggler_time == duration(30 + 30));
+}
+
+TEST_CASE("[imbalance] sets", "All sets are analyzed in order")
+{
+    io_graph_fixture fx;
+    fx.data(0, "a", io_event_kind::write, 0, 100, duration(10), at(10));
+    fx.data(1, "a", io_event_kind::write, 0, 100, duration(20), at(20));
+    set_container_t<VertexDescriptor> sets(5, fx.set);
+    sets[3] = set_t<VertexDescriptor>();
+
+    const auto res = analyze_imbalance(fx.graph, sets);
+    REQUIRE(res.size() == 5);
+    REQUIRE(res[0].procs.size() == 2);
+    REQUIRE(res[3].procs.empty());
+    REQUIRE(res[4].straggler_wait == duration(10));
+    REQUIRE(res[4].end_sync_time == duration(0));
+}
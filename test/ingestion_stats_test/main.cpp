@@ -0,0 +1,87 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/graph/ingestion_stats.hpp>
+
+#include <sstream>
+
+using namespace rabbitxx::graph;
+
+namespace
+{
+
+// just the part of the graph interface the guard needs
+struct counting_graph
+{
+    std::uint64_t num_vertices() const noexcept
+    {
+        return vertices;
+    }
+
+    std::uint64_t vertices = 0;
+};
+
+} // namespace
+
+TEST_CASE("[ingestion_guard]", "Events are counted as seen, filtered or converted")
+{
+    ingestion_stats stats;
+    counting_graph graph;
+
+    {
+        ingestion_guard<counting_graph> guard(stats, callback_type::enter, graph);
+    }
+    {
+        ingestion_guard<counting_graph> guard(stats, callback_type::io_operation_complete, graph);
+        guard.bytes(4096);
+        ++graph.vertices;
+    }
+    {
+        ingestion_guard<counting_graph> guard(stats, callback_type::io_operation_complete, graph);
+        guard.bytes(1024);
+        // folded into the previous vertex
+        guard.converted();
+    }
+    {
+        ingestion_guard<counting_graph> guard(stats, callback_type::io_operation_complete, graph);
+        guard.filtered();
+    }
+
+    const auto summary = stats.summary();
+    REQUIRE(stats.events_seen() == 4);
+
+    const auto& enter = summary[callback_type::enter];
+    REQUIRE(enter.seen == 1);
+    REQUIRE(enter.filtered == 0);
+    REQUIRE(enter.converted == 0);
+
+    const auto& complete = summary[callback_type::io_operation_complete];
+    REQUIRE(complete.seen == 3);
+    REQUIRE(complete.filtered == 1);
+    REQUIRE(complete.converted == 2);
+    REQUIRE(complete.bytes == 5120);
+
+    const auto total = summary.total();
+    REQUIRE(total.seen == 4);
+    REQUIRE(total.converted == 2);
+    REQUIRE(summary[callback_type::mpi_send].seen == 0);
+}
+
+TEST_CASE("[ingestion_summary]", "Only callbacks with events are printed")
+{
+    ingestion_stats stats;
+    stats.set_expected_events(10);
+    counting_graph graph;
+    {
+        ingestion_guard<counting_graph> guard(stats, callback_type::mpi_send, graph);
+        guard.bytes(8);
+    }
+    const auto summary = stats.summary();
+    REQUIRE(summary.expected_events == 10);
+
+    std::ostringstream out;
+    out << summary;
+    REQUIRE(out.str().find("mpi_send") != std::string::npos);
+    REQUIRE(out.str().find("mpi_receive") == std::string::npos);
+    REQUIRE(std::string(to_string(callback_type::io_seek)) == "io_seek");
+}
@@ -0,0 +1,125 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/graph.hpp>
+
+#include <map>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator_layered test: 4 locations, 2 phases of 4
+// MPI-IO writes, each carried out by two nested POSIX writes of half the size
+// in pwrite regions nested in the MPI_File_write region
+const std::uint64_t num_locations = 4;
+const std::uint64_t num_phases = 2;
+const std::uint64_t io_per_phase = 4;
+const std::uint64_t bytes_per_io = 4096;
+const std::string mpiio = "MPI I/O";
+const std::string posix = "POSIX I/O";
+
+IoGraph build_graph(const filter_spec& filter = filter_spec())
+{
+    graph::builder_config config;
+    config.keep_all_layers = true;
+    config.filter = filter;
+    return make_graph<graph::OTF2_Io_Graph_Builder>(LAYERED_TRACE, config);
+}
+
+std::vector<VertexDescriptor> writes(const IoGraph& graph, const std::string& paradigm)
+{
+    std::vector<VertexDescriptor> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::io_event) {
+            continue;
+        }
+        const auto& io_op = boost::get<io_event_property>(graph[*it].property);
+        if (io_op.kind == io_event_kind::write && io_op.paradigm == paradigm) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("[io_layers]", "Nested operations link to the operation they are part of")
+{
+    const auto graph = build_graph();
+    const auto parents = writes(graph, mpiio);
+    const auto children = writes(graph, posix);
+    REQUIRE(parents.size() == num_locations * num_phases * io_per_phase);
+    REQUIRE(children.size() == 2 * parents.size());
+
+    std::map<VertexDescriptor, std::uint64_t> num_children;
+    for (const auto vd : children)
+    {
+        const auto& child = boost::get<io_event_property>(graph[vd].property);
+        // the POSIX write completes before the MPI-IO write it is part of
+        REQUIRE(child.has_parent_event());
+        const auto& parent = boost::get<io_event_property>(graph[child.parent_event].property);
+        REQUIRE(parent.paradigm == mpiio);
+        REQUIRE(parent.proc_id == child.proc_id);
+        REQUIRE(parent.timestamp - *parent.iop_duration < child.timestamp - *child.iop_duration);
+        REQUIRE(child.timestamp < parent.timestamp);
+        ++num_children[child.parent_event];
+    }
+    REQUIRE(num_children.size() == parents.size());
+    for (const auto& kvp : num_children)
+    {
+        REQUIRE(kvp.second == 2);
+        const auto& parent = boost::get<io_event_property>(graph[kvp.first].property);
+        REQUIRE(parent.response_size == bytes_per_io);
+        REQUIRE(!parent.has_parent_event());
+    }
+}
+
+TEST_CASE("[io_layers_sets]", "The sets of a layer hold the I/O of its paradigm only")
+{
+    auto graph = build_graph();
+    REQUIRE(io_layers(graph) == std::set<std::string>({ mpiio, posix }));
+
+    for (const auto& paradigm : { mpiio, posix })
+    {
+        auto sets_per_process = cio_sets_per_process(graph);
+        restrict_to_layer(graph, sets_per_process, paradigm);
+        const auto cio_sets = find_cio_sets(graph, sets_per_process);
+        std::size_t num_writes = 0;
+        for (const auto& set : cio_sets)
+        {
+            for (const auto vd : set)
+            {
+                const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+                REQUIRE(io_op.paradigm == paradigm);
+                if (io_op.kind == io_event_kind::write) {
+                    ++num_writes;
+                }
+            }
+        }
+        REQUIRE(num_writes == writes(graph, paradigm).size());
+    }
+}
+
+TEST_CASE("[io_layers_regions]", "Regions called from a filtered region are filtered as well")
+{
+    const auto num_writes = num_locations * num_phases * io_per_phase;
+
+    filter_spec included;
+    included.included_regions = { "MPI_File_write" };
+    const auto kept = build_graph(included);
+    // the POSIX writes in the nested pwrite regions are within MPI_File_write
+    REQUIRE(writes(kept, mpiio).size() == num_writes);
+    REQUIRE(writes(kept, posix).size() == 2 * num_writes);
+
+    filter_spec excluded;
+    excluded.excluded_regions = { "MPI_File_write" };
+    const auto dropped = build_graph(excluded);
+    REQUIRE(writes(dropped, mpiio).empty());
+    REQUIRE(writes(dropped, posix).empty());
+}
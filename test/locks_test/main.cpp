@@ -0,0 +1,95 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/locks.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+namespace
+{
+
+io_lock_interval make_lock(std::uint64_t pid, const std::string& file, otf2::common::lock_type type,
+                        std::int64_t requested, std::int64_t acquired, std::int64_t released,
+                        std::uint64_t failed_tries = 0)
+{
+    io_lock_interval lock;
+    lock.proc_id = pid;
+    lock.filename = file;
+    lock.handle = pid;
+    lock.type = type;
+    lock.requested = at(requested);
+    lock.acquired = at(acquired);
+    lock.released = at(released);
+    lock.failed_tries = failed_tries;
+    return lock;
+}
+
+// exclusive locks on "a" serialize processes 0 and 1, a shared lock of
+// process 2 waits for process 1, "b" is just locked by process 0
+std::vector<io_lock_interval> make_locks()
+{
+    const auto excl = otf2::common::lock_type::exclusive;
+    const auto shrd = otf2::common::lock_type::shared;
+    return {
+        make_lock(0, "a", excl, 10, 10, 50),
+        make_lock(1, "a", excl, 20, 50, 70, 2),
+        make_lock(2, "a", shrd, 60, 70, 80),
+        make_lock(0, "a", shrd, 75, 75, 90),
+        make_lock(0, "b", excl, 100, 100, 110),
+        make_lock(0, "b", excl, 110, 110, 120),
+    };
+}
+
+} // namespace
+
+TEST_CASE("[locks]", "Wait and hold times of all locks")
+{
+    const auto locks = make_locks();
+    const auto summary = analyze_locks(locks);
+
+    REQUIRE(summary.total.locks == 6);
+    REQUIRE(summary.total.exclusive == 4);
+    REQUIRE(summary.total.shared == 2);
+    REQUIRE(summary.total.contended == 2);
+    // processes 1 and 2 waited, process 0 never did
+    REQUIRE(summary.total.contenders == 2);
+    REQUIRE(summary.total.failed_tries == 2);
+
+    REQUIRE(summary.files.size() == 2);
+    const auto& a = summary.files[0];
+    REQUIRE(a.filename == "a");
+    REQUIRE(a.contention.contended == 2);
+    REQUIRE(a.contention.contenders == 2);
+    REQUIRE(a.contention.wait_time == duration(40));
+    REQUIRE(a.contention.max_wait == duration(30));
+    REQUIRE(a.contention.hold_time == duration(85));
+    REQUIRE(a.contention.max_hold == duration(40));
+    REQUIRE(a.contention.contended_fraction() == Approx(0.5));
+
+    // locks of the same process do not contend
+    const auto& b = summary.files[1];
+    REQUIRE(b.filename == "b");
+    REQUIRE(b.contention.locks == 2);
+    REQUIRE(b.contention.contended == 0);
+    REQUIRE(b.contention.contenders == 0);
+}
+
+TEST_CASE("[locks_set]", "Locks overlapping the time span of a set")
+{
+    io_graph_fixture fx;
+    fx.properties().lock_intervals = make_locks();
+    // a write from 50 to 60
+    fx.data(0, "a", io_event_kind::write, 0, 10, duration(10), at(60));
+
+    const auto summary = analyze_locks(fx.graph, fx.set);
+    REQUIRE(summary.total.locks == 3);
+    REQUIRE(summary.total.contended == 2);
+    REQUIRE(summary.total.contenders == 2);
+    REQUIRE(summary.files.size() == 1);
+    REQUIRE(summary.files[0].filename == "a");
+
+    REQUIRE(analyze_locks(fx.graph, set_t<VertexDescriptor>()).total.locks == 0);
+}
@@ -0,0 +1,82 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/mapping.hpp>
+
+#include <numeric>
+
+using namespace rabbitxx::detail;
+
+TEST_CASE("[block_mapping]", "Consecutive locations on the same rank")
+{
+    block_mapping strategy(3, 10);
+    std::vector<int> per_rank(3, 0);
+    int last_rank = 0;
+    for (std::uint64_t loc = 0; loc < 10; ++loc)
+    {
+        const auto rank = strategy(loc);
+        REQUIRE(rank >= last_rank);
+        REQUIRE(rank < 3);
+        ++per_rank[rank];
+        last_rank = rank;
+    }
+    const auto mm = std::minmax_element(per_rank.begin(), per_rank.end());
+    REQUIRE(*mm.second - *mm.first <= 1);
+
+    // more ranks than locations
+    block_mapping sparse(8, 2);
+    REQUIRE(sparse(0) == 0);
+    REQUIRE(sparse(1) == 4);
+
+    SECTION("No announced locations")
+    {
+        block_mapping empty(4, 0);
+        REQUIRE(empty(0) == 0);
+        REQUIRE(empty(5) == 3);
+    }
+
+    SECTION("Sparse location references")
+    {
+        block_mapping strategy(2, 4);
+        strategy.assign({ 40, 10, 30, 20 });
+        REQUIRE(strategy(10) == 0);
+        REQUIRE(strategy(20) == 0);
+        REQUIRE(strategy(30) == 1);
+        REQUIRE(strategy(40) == 1);
+    }
+}
+
+TEST_CASE("[round_robin_mapping]", "Closed form round-robin")
+{
+    round_robin_mapping strategy(4, 10);
+    REQUIRE(strategy(0) == 0);
+    REQUIRE(strategy(3) == 3);
+    REQUIRE(strategy(4) == 0);
+    REQUIRE(strategy(9) == 1);
+}
+
+TEST_CASE("[weighted_greedy_mapping]", "Balance event counts across ranks")
+{
+    weighted_greedy_mapping strategy(2, 6);
+    // location 0 is an aggregator with as many events as all others together
+    strategy.assign({ { 0, 500 }, { 1, 100 }, { 2, 100 }, { 3, 100 }, { 4, 100 }, { 5, 100 } });
+
+    std::vector<std::uint64_t> load(2, 0);
+    const std::vector<std::uint64_t> weights { 500, 100, 100, 100, 100, 100 };
+    for (std::uint64_t loc = 0; loc < 6; ++loc)
+    {
+        load[strategy(loc)] += weights[loc];
+    }
+    REQUIRE(load[0] == 500);
+    REQUIRE(load[1] == 500);
+    // the aggregator is alone
+    for (std::uint64_t loc = 1; loc < 6; ++loc)
+    {
+        REQUIRE(strategy(loc) != strategy(0));
+    }
+
+    SECTION("Unknown locations fall back to round-robin")
+    {
+        REQUIRE(strategy(7) == 1);
+    }
+}
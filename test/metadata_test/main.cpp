@@ -0,0 +1,82 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "io_graph_fixture.hpp"
+
+#include <rabbitxx/analysis/metadata.hpp>
+
+using namespace rabbitxx;
+using namespace rabbitxx::analysis;
+using namespace rabbitxx::test;
+
+TEST_CASE("[metadata] trie", "Files are mapped to their directory")
+{
+    directory_trie trie;
+    const auto out = trie.insert("/scratch/run/out/rank0");
+    REQUIRE(trie.insert("/scratch/run/out/rank1") == out);
+    REQUIRE(trie.insert("/scratch//run/out/rank2") == out);
+    REQUIRE(trie.directory_of("/scratch/run/out/rank1") == out);
+    REQUIRE(trie.directory_of("/unknown") == directory_trie::npos);
+    REQUIRE(trie.path(out) == "/scratch/run/out");
+    REQUIRE(trie.depth(out) == 3);
+    REQUIRE(trie.path(trie.ancestor(out, 1)) == "/scratch");
+    REQUIRE(trie.insert("stdout") == directory_trie::root);
+    REQUIRE(trie.path(directory_trie::root) == "/");
+    // root, scratch, run and out
+    REQUIRE(trie.size() == 4);
+}
+
+TEST_CASE("[metadata] set", "Metadata operations per directory and prefix")
+{
+    io_graph_fixture fx;
+    // file per process creates in /scratch/run/out
+    for (std::uint64_t pid = 0; pid < 4; ++pid)
+    {
+        fx.metadata(pid, "/scratch/run/out/rank" + std::to_string(pid), io_event_kind::create, duration(5), at(10 + pid));
+        fx.data(pid, "/scratch/run/out/rank" + std::to_string(pid), io_event_kind::write, 0, 0, duration(5), at(20 + pid));
+        fx.metadata(pid, "/scratch/run/out/rank" + std::to_string(pid), io_event_kind::delete_or_close, duration(5), at(1000 + pid));
+    }
+    fx.metadata(0, "/scratch/run/input", io_event_kind::create, duration(5), at(5));
+    fx.metadata(0, "/scratch/run/input", io_event_kind::dup, duration(5), at(6));
+
+    const auto trie = make_directory_trie(fx.graph);
+    metadata_config config;
+    config.window = duration(100);
+    config.prefix_depth = 2;
+    config.storm_rate = 4 / std::chrono::duration<double>(duration(100)).count();
+    const auto res = analyze_metadata(fx.graph, trie, fx.set, config);
+
+    REQUIRE(res.directories.size() == 2);
+    const auto& run = res.directories[0];
+    REQUIRE(run.path == "/scratch/run");
+    REQUIRE(run.creates == 1);
+    REQUIRE(run.dups == 1);
+    REQUIRE(run.peak_window_ops == 2);
+    REQUIRE(!run.storm);
+
+    const auto& out = res.directories[1];
+    REQUIRE(out.path == "/scratch/run/out");
+    REQUIRE(out.creates == 4);
+    REQUIRE(out.closes == 4);
+    REQUIRE(out.num_procs == 4);
+    REQUIRE(out.num_files == 4);
+    REQUIRE(out.time == duration(40));
+    REQUIRE(out.peak_window_ops == 4);
+    REQUIRE(out.storm);
+
+    REQUIRE(res.prefixes.size() == 1);
+    REQUIRE(res.prefixes[0].path == "/scratch/run");
+    REQUIRE(res.prefixes[0].num_ops() == 10);
+    REQUIRE(res.prefixes[0].peak_window_ops == 6);
+}
+
+TEST_CASE("[metadata] window", "A non-positive window is rejected")
+{
+    io_graph_fixture fx;
+    fx.metadata(0, "/scratch/run/input", io_event_kind::create, duration(5), at(5));
+    const auto trie = make_directory_trie(fx.graph);
+    metadata_config config;
+    config.window = duration(0);
+    REQUIRE_THROWS_AS(analyze_metadata(fx.graph, trie, fx.set, config), std::invalid_argument);
+    config.window = duration(-1);
+    REQUIRE_THROWS_AS(analyze_metadata(fx.graph, trie, fx.set, config), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/graph.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+// written by the trace_generator test: 8 locations, 3 phases of 4 writes to
+// a shared file, separated by barriers. Every event takes one nanosecond
+// tick, the phases start at tick 4 and take 20 ticks each.
+const std::uint64_t num_locations = 8;
+const std::uint64_t num_phases = 3;
+const std::uint64_t io_per_phase = 4;
+const std::int64_t first_phase = 4;
+const std::int64_t ticks_per_phase = 20;
+
+otf2::chrono::time_point at(std::int64_t ticks)
+{
+    return otf2::chrono::time_point(otf2::chrono::duration(ticks));
+}
+
+std::vector<VertexDescriptor> of_kind(const IoGraph& graph, vertex_kind kind)
+{
+    std::vector<VertexDescriptor> result;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type == kind) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+VertexDescriptor synthetic_vertex(const IoGraph& graph, const std::string& name)
+{
+    for (const auto vd : of_kind(graph, vertex_kind::synthetic))
+    {
+        if (graph[vd].name() == name) {
+            return vd;
+        }
+    }
+    return IoGraph::null_vertex();
+}
+
+std::uint64_t in_degree(const IoGraph& graph, VertexDescriptor target)
+{
+    std::uint64_t degree = 0;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        const auto adjacent = boost::adjacent_vertices(*it, *graph.get());
+        degree += std::count(adjacent.first, adjacent.second, target);
+    }
+    return degree;
+}
+
+} // namespace
+
+TEST_CASE("[window]", "The graph of a time window spans the window")
+{
+    // the second phase, from its first event to the leave of its barrier
+    graph::builder_config config;
+    config.window_begin = at(first_phase + ticks_per_phase + 1);
+    config.window_end = at(first_phase + 2 * ticks_per_phase);
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+
+    const auto root = synthetic_vertex(graph, "Root");
+    const auto end = synthetic_vertex(graph, "End");
+    REQUIRE(root != IoGraph::null_vertex());
+    REQUIRE(end != IoGraph::null_vertex());
+    REQUIRE(graph[root].timestamp() == config.window_begin);
+    REQUIRE(graph[end].timestamp() == config.window_end);
+    REQUIRE(graph.out_degree(root) == num_locations);
+    REQUIRE(in_degree(graph, end) == num_locations);
+
+    // just the writes of the phase, open and close are outside
+    const auto io = of_kind(graph, vertex_kind::io_event);
+    REQUIRE(io.size() == num_locations * io_per_phase);
+    for (const auto vd : io)
+    {
+        const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+        REQUIRE(io_op.kind == io_event_kind::write);
+        REQUIRE(io_op.timestamp >= config.window_begin);
+        REQUIRE(io_op.timestamp <= config.window_end);
+    }
+    // the barrier of the phase is complete
+    const auto syncs = of_kind(graph, vertex_kind::sync_event);
+    REQUIRE(syncs.size() == num_locations);
+    for (const auto vd : syncs)
+    {
+        const auto& sync = boost::get<sync_event_property>(graph[vd].property);
+        REQUIRE(sync.root_event != std::numeric_limits<std::size_t>::max());
+    }
+
+    const auto& info = graph.graph_properties();
+    REQUIRE(info.first_event_time >= config.window_begin);
+    REQUIRE(info.last_event_time <= config.window_end);
+    REQUIRE(info.num_locations == num_locations);
+}
+
+TEST_CASE("[location_subset]", "The selected locations get dense process ids")
+{
+    graph::builder_config config;
+    config.locations = { 2, 5, 7 };
+    const auto graph = make_graph<graph::OTF2_Io_Graph_Builder>(SYNTHETIC_TRACE, config);
+
+    const auto& info = graph.graph_properties();
+    REQUIRE(info.num_locations == 3);
+    REQUIRE(info.locations == std::vector<std::uint64_t>({ 2, 5, 7 }));
+
+    const auto root = synthetic_vertex(graph, "Root");
+    const auto end = synthetic_vertex(graph, "End");
+    REQUIRE(graph[root].timestamp() == at(0));
+    REQUIRE(graph[end].timestamp() == otf2::chrono::time_point::max());
+    REQUIRE(graph.out_degree(root) == 3);
+    REQUIRE(in_degree(graph, end) == 3);
+
+    // open, the writes and close of each process
+    std::map<std::uint64_t, std::uint64_t> writes;
+    for (const auto vd : of_kind(graph, vertex_kind::io_event))
+    {
+        const auto& io_op = boost::get<io_event_property>(graph[vd].property);
+        REQUIRE(io_op.proc_id < 3);
+        if (io_op.kind == io_event_kind::write) {
+            ++writes[io_op.proc_id];
+        }
+    }
+    REQUIRE(writes == std::map<std::uint64_t, std::uint64_t>(
+                { { 0, num_phases * io_per_phase },
+                  { 1, num_phases * io_per_phase },
+                  { 2, num_phases * io_per_phase } }));
+
+    // the barriers over all locations are restricted to the selected ones
+    const auto syncs = of_kind(graph, vertex_kind::sync_event);
+    REQUIRE(syncs.size() == 3 * num_phases);
+    for (const auto vd : syncs)
+    {
+        const auto& sync = boost::get<sync_event_property>(graph[vd].property);
+        REQUIRE(sync.proc_id < 3);
+        const auto members = boost::get<collective>(sync.op_data).members();
+        REQUIRE(std::set<std::uint64_t>(members.begin(), members.end())
+                == std::set<std::uint64_t>({ 0, 1, 2 }));
+        REQUIRE(sync.root_event != std::numeric_limits<std::size_t>::max());
+    }
+}
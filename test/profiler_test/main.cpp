@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/profiler.hpp>
+
+#include <sstream>
+#include <vector>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+void busy_phase(const std::string& name)
+{
+    profile_scope scope(name);
+    std::vector<int> v(1 << 16, 1);
+    volatile int sum = 0;
+    for (const auto i : v)
+    {
+        sum += i;
+    }
+}
+
+} // namespace
+
+TEST_CASE("[profiler_tree]", "Nested phases form a tree")
+{
+    profiler::global().reset();
+    {
+        profile_scope outer("graph construction");
+        busy_phase("read definitions");
+        busy_phase("read events");
+    }
+    busy_phase("merge");
+
+    const auto& prof = profiler::global().result();
+    const auto top = prof.children(profile_entry::no_parent);
+    REQUIRE(top.size() == 2);
+    REQUIRE(prof[top[0]].name == "graph construction");
+    REQUIRE(prof[top[1]].name == "merge");
+    REQUIRE(prof[top[1]].depth == 0);
+
+    const auto children = prof.children(top[0]);
+    REQUIRE(children.size() == 2);
+    REQUIRE(prof[children[0]].name == "read definitions");
+    REQUIRE(prof[children[1]].name == "read events");
+    REQUIRE(prof[children[0]].depth == 1);
+
+    // the parent includes the time of its children
+    REQUIRE(prof[top[0]].wall >= prof[children[0]].wall + prof[children[1]].wall);
+    REQUIRE(prof[top[0]].calls == 1);
+}
+
+TEST_CASE("[profiler_accumulate]", "Repeated phases are accumulated")
+{
+    profiler::global().reset();
+    for (int i = 0; i < 3; ++i)
+    {
+        busy_phase("dedup");
+    }
+    const auto& prof = profiler::global().result();
+    REQUIRE(prof.entries().size() == 1);
+    REQUIRE(prof[0].calls == 3);
+    if (profiler::counts_allocations())
+    {
+        REQUIRE(prof[0].allocations >= 3);
+        REQUIRE(prof[0].allocated_bytes >= 3 * (1 << 16) * sizeof(int));
+    }
+
+    std::ostringstream out;
+    out << prof;
+    REQUIRE(out.str().find("dedup") != std::string::npos);
+    REQUIRE(out.str().find("3 calls") != std::string::npos);
+
+    profiler::global().reset();
+    REQUIRE(profiler::global().result().empty());
+}
@@ -0,0 +1,220 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <rabbitxx/cio_set.hpp>
+#include <rabbitxx/analysis/io_stream.hpp>
+#include <rabbitxx/graph/builder/sync_matching.hpp>
+#include <rabbitxx/synthetic_graph.hpp>
+
+using namespace rabbitxx;
+
+namespace
+{
+
+std::uint64_t count_kind(const IoGraph& graph, vertex_kind kind)
+{
+    std::uint64_t count = 0;
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type == kind) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool all_roots_set(const IoGraph& graph)
+{
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::sync_event) {
+            continue;
+        }
+        const auto& sync = boost::get<sync_event_property>(graph[*it].property);
+        if (sync.root_event == std::numeric_limits<size_t>::max()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("[synthetic_graph]", "Structure of synthetic graphs")
+{
+    synthetic_graph_config cfg;
+    cfg.num_procs = 8;
+    cfg.num_phases = 3;
+    cfg.io_per_phase = 4;
+
+    auto graph = make_synthetic_graph(cfg);
+
+    // root, end, open and close per process
+    REQUIRE(count_kind(graph, vertex_kind::synthetic) == 2);
+    REQUIRE(count_kind(graph, vertex_kind::io_event) == 8 * (2 + 3 * 4));
+    REQUIRE(count_kind(graph, vertex_kind::sync_event) == 8 * 3);
+    REQUIRE(find_root(graph) == 0);
+    REQUIRE(graph.out_degree(0) == 8);
+    REQUIRE(num_procs(graph) == 8);
+    REQUIRE(all_roots_set(graph));
+    // one chain per process, plus a barrier root connected to 7 processes per phase
+    REQUIRE(graph.num_edges() == 8 + (graph.num_vertices() - 2) + 3 * 7);
+    REQUIRE(graph.graph_properties().num_locations == 8);
+
+    SECTION("Sets per process and merged sets")
+    {
+        auto sets_pp = cio_sets_per_process(graph);
+        REQUIRE(sets_pp.size() == 8);
+        auto cio_sets = find_cio_sets(graph, sets_pp);
+        // each phase is one set of concurrent I/O, plus the set after the last barrier
+        REQUIRE(cio_sets.size() == 4);
+    }
+
+    SECTION("Sets of one layer")
+    {
+        REQUIRE(io_layers(graph) == std::set<std::string>{ "POSIX" });
+        auto posix_sets = cio_sets_per_process(graph);
+        restrict_to_layer(graph, posix_sets, "POSIX");
+        REQUIRE(find_cio_sets(graph, posix_sets).size() == 4);
+        auto mpiio_sets = cio_sets_per_process(graph);
+        restrict_to_layer(graph, mpiio_sets, "MPI-IO");
+        REQUIRE(find_cio_sets(graph, mpiio_sets).empty());
+    }
+
+    SECTION("Same seed, same graph")
+    {
+        cfg.p2p_density = 0.5;
+        cfg.comm_size = 4;
+        auto g1 = make_synthetic_graph(cfg);
+        auto g2 = make_synthetic_graph(cfg);
+        REQUIRE(g1.num_vertices() == g2.num_vertices());
+        REQUIRE(g1.num_edges() == g2.num_edges());
+        REQUIRE(all_roots_set(g1));
+    }
+}
+
+TEST_CASE("[sync_matching]", "Match messages of a hub process in order")
+{
+    // process 4 exchanges two rounds of messages with processes 0..3,
+    // every process completes them in the order they were posted
+    const std::uint64_t hub = 4;
+    const auto ts = otf2::chrono::time_point();
+    IoGraph graph;
+    std::map<std::uint64_t, std::deque<VertexDescriptor>> synchronizations;
+    std::vector<std::pair<VertexDescriptor, VertexDescriptor>> pairs;
+    for (std::uint64_t round = 0; round < 2; ++round)
+    {
+        for (std::uint64_t p = 0; p < hub; ++p)
+        {
+            const auto send = graph.add_vertex(otf2_trace_event(
+                        sync_event_property(hub, "MPI_Wait", peer2peer(p, 0, 8, round), ts)));
+            synchronizations[hub].push_back(send);
+            const auto recv = graph.add_vertex(otf2_trace_event(
+                        sync_event_property(p, "MPI_Wait", peer2peer(hub, 0, 8, round), ts)));
+            synchronizations[p].push_back(recv);
+            pairs.emplace_back(send, recv);
+        }
+    }
+
+    REQUIRE(graph::match_synchronizations(graph, synchronizations, false));
+    REQUIRE(graph.num_edges() == pairs.size());
+    for (const auto& send_recv : pairs)
+    {
+        // the receiver comes first, so it is the root of the pair
+        const auto& send = boost::get<sync_event_property>(graph[send_recv.first].property);
+        REQUIRE(send.root_event == send_recv.second);
+    }
+}
+
+TEST_CASE("[sync_matching_tags]", "Match messages by tag, not by the order they were posted")
+{
+    // process 0 sends tags 1 and 2, process 1 receives them the other way round
+    const auto ts = otf2::chrono::time_point();
+    IoGraph graph;
+    std::map<std::uint64_t, std::deque<VertexDescriptor>> synchronizations;
+    std::map<std::uint32_t, std::pair<VertexDescriptor, VertexDescriptor>> pairs;
+    for (const std::uint32_t tag : { 1, 2 })
+    {
+        const auto send = graph.add_vertex(otf2_trace_event(
+                    sync_event_property(0, "MPI_Send", peer2peer(1, tag, 8), ts)));
+        synchronizations[0].push_back(send);
+        pairs[tag].first = send;
+    }
+    for (const std::uint32_t tag : { 2, 1 })
+    {
+        const auto recv = graph.add_vertex(otf2_trace_event(
+                    sync_event_property(1, "MPI_Recv", peer2peer(0, tag, 8), ts)));
+        synchronizations[1].push_back(recv);
+        pairs[tag].second = recv;
+    }
+
+    REQUIRE(graph::match_synchronizations(graph, synchronizations, false));
+    REQUIRE(graph.num_edges() == pairs.size());
+    for (const auto& kvp : pairs)
+    {
+        const auto& recv = boost::get<sync_event_property>(graph[kvp.second.second].property);
+        REQUIRE(recv.root_event == kvp.second.first);
+        REQUIRE(boost::edge(kvp.second.first, kvp.second.second, *graph.get()).second);
+    }
+}
+
+TEST_CASE("[synthetic_offsets]", "Writes store the file position after the operation")
+{
+    synthetic_graph_config cfg;
+    cfg.num_procs = 4;
+    cfg.num_phases = 2;
+    cfg.io_per_phase = 3;
+    cfg.bytes_per_io = 100;
+
+    for (const auto shared : { false, true })
+    {
+        cfg.shared_file = shared;
+        const auto graph = make_synthetic_graph(cfg);
+        // begin offsets of the writes per process, in creation order
+        std::vector<std::vector<std::uint64_t>> begins(cfg.num_procs);
+        const auto vertices = graph.vertices();
+        for (auto it = vertices.first; it != vertices.second; ++it)
+        {
+            if (graph[*it].type != vertex_kind::io_event) {
+                continue;
+            }
+            const auto& io = boost::get<io_event_property>(graph[*it].property);
+            if (io.kind == io_event_kind::write) {
+                begins[io.proc_id].push_back(analysis::begin_offset(io));
+            }
+        }
+        for (std::uint64_t pid = 0; pid < cfg.num_procs; ++pid)
+        {
+            REQUIRE(begins[pid].size() == 6);
+            for (std::uint64_t n = 0; n < begins[pid].size(); ++n)
+            {
+                // contiguous per file, or every process owns one block per round
+                const auto expected = shared ? (n * cfg.num_procs + pid) * cfg.bytes_per_io
+                                             : n * cfg.bytes_per_io;
+                REQUIRE(begins[pid][n] == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("[synthetic_timestamps]", "I/O vertices store their completion as timestamp")
+{
+    synthetic_graph_config cfg;
+    cfg.num_procs = 4;
+    cfg.num_phases = 2;
+    const auto graph = make_synthetic_graph(cfg);
+    const auto vertices = graph.vertices();
+    for (auto it = vertices.first; it != vertices.second; ++it)
+    {
+        if (graph[*it].type != vertex_kind::io_event) {
+            continue;
+        }
+        const auto& io = boost::get<io_event_property>(graph[*it].property);
+        REQUIRE(io.timestamp == graph[*it].duration.leave);
+        if (io.iop_duration) {
+            REQUIRE(io.timestamp - *io.iop_duration == graph[*it].duration.enter);
+        }
+    }
+}
@@ -0,0 +1,668 @@
+#include <otf2xx/otf2.hpp>
+#include <otf2xx/writer/archive.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Generate synthetic OTF2 traces, which can be read by the I/O graph builder.
+ *
+ * Every location executes the same number of phases. Each phase consists of a
+ * configurable number of POSIX writes or reads followed by a synchronization:
+ *
+ *  barrier:    MPI_Barrier over all locations
+ *  allreduce:  MPI_Allreduce over all locations
+ *  p2p:        ring exchange, send to the right neighbour, receive from the left
+ *  ip2p:       non-blocking ring exchange of two messages with distinct tags,
+ *              completed in MPI_Waitall, the receives in reverse order
+ *  none:       no synchronization, every phase is concurrent
+ *
+ * The files are opened before the first and closed after the last phase.
+ * Either all locations access one shared file or every location accesses a
+ * file of its own. The handles are scoped to MPI_COMM_WORLD, or to one of
+ * `groups` sub-communicators, location `i` belongs to group `i % groups`.
+ *
+ * With `layered` every operation is an MPI-IO operation, which is carried out
+ * by two POSIX operations of half the size on a child handle, each in a
+ * pwrite or pread region nested in the MPI-IO region. The POSIX operations
+ * complete before the MPI-IO operation they are part of.
+ *
+ * With `dup` every location duplicates its handle and opens the file a
+ * second time under the same name. The operations cycle through the handle,
+ * its duplicate, which shares the file position, and the second handle,
+ * which has a position of its own.
+ */
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+struct generator_config
+{
+    std::uint64_t num_locations = 4;
+    std::uint64_t num_phases = 2;
+    std::uint64_t io_per_phase = 4;
+    std::uint64_t bytes_per_io = 4096;
+    std::string sync = "barrier";
+    bool shared_file = true;
+    bool read = false;
+    // non-blocking I/O, completed in reverse order at the end of each phase
+    bool async = false;
+    // collective I/O, like MPI_File_write_all, over the communicator of the handle
+    bool collective = false;
+    std::uint64_t groups = 1;
+    // MPI-IO operations on top of nested POSIX operations
+    bool layered = false;
+    // operations through a duplicated and a second handle of the file
+    bool dup = false;
+};
+
+// every event gets its own nanosecond tick
+struct tick_clock
+{
+    otf2::chrono::time_point operator()()
+    {
+        return otf2::chrono::time_point(otf2::chrono::duration(++ticks_));
+    }
+
+    void advance_to(std::uint64_t ticks)
+    {
+        ticks_ = std::max(ticks_, ticks);
+    }
+
+    std::uint64_t ticks() const noexcept
+    {
+        return ticks_;
+    }
+
+private:
+    std::uint64_t ticks_ = 0;
+};
+
+// string references
+enum : std::uint64_t
+{
+    str_empty,
+    str_machine,
+    str_node,
+    str_posix_id,
+    str_posix,
+    str_open,
+    str_close,
+    str_io,
+    str_sync,
+    str_world,
+    str_shared_file,
+    str_wait,
+    str_mpiio_id,
+    str_mpiio,
+    str_waitall,
+    str_posix_io,
+    str_first_dynamic
+};
+
+// region references
+enum : std::uint64_t
+{
+    reg_open,
+    reg_close,
+    reg_io,
+    reg_sync,
+    reg_wait,
+    reg_waitall,
+    reg_posix_io
+};
+
+std::string sync_region_name(const std::string& sync)
+{
+    if (sync == "barrier")
+    {
+        return "MPI_Barrier";
+    }
+    if (sync == "allreduce")
+    {
+        return "MPI_Allreduce";
+    }
+    if (sync == "ip2p")
+    {
+        return "MPI_Isendrecv";
+    }
+    return "MPI_Sendrecv";
+}
+
+/**
+ * @brief Number of events written per location, stored in the location
+ * definition so readers can estimate the graph size.
+ */
+std::uint64_t events_per_location(const generator_config& cfg)
+{
+    // enter, create/destroy handle, leave
+    std::uint64_t open_close = 2 * 3;
+    // enter, begin, complete, leave
+    std::uint64_t io = cfg.num_phases * cfg.io_per_phase * 4;
+    if (cfg.dup)
+    {
+        // the duplicate and the second handle are created and destroyed as well
+        open_close = 2 * 5;
+    }
+    if (cfg.layered)
+    {
+        // the MPI-IO handle is created and destroyed as well
+        open_close = 2 * 4;
+        // and two POSIX enters, begins, completes and leaves per operation
+        io = cfg.num_phases * cfg.io_per_phase * 12;
+    }
+    if (cfg.async)
+    {
+        // enter, begin, issued, leave per operation
+        // and enter, test, one complete per operation, leave per phase
+        io = cfg.num_phases * (cfg.io_per_phase * 5 + 3);
+    }
+    std::uint64_t sync = 0;
+    if (cfg.sync == "barrier" || cfg.sync == "allreduce")
+    {
+        // enter, collective begin, collective end, leave
+        sync = cfg.num_phases * 4;
+    }
+    else if (cfg.sync == "p2p")
+    {
+        // enter, send, receive, leave
+        sync = cfg.num_phases * 4;
+    }
+    else if (cfg.sync == "ip2p")
+    {
+        // enter, two sends and receive requests, leave
+        // and enter, two receives and send completions, leave
+        sync = cfg.num_phases * 12;
+    }
+    return open_close + io + sync;
+}
+
+void write_trace(const generator_config& cfg, const std::string& path, const std::string& name)
+{
+    using otf2::definition::string;
+
+    otf2::writer::archive ar(path, name);
+
+    // nanosecond resolution, the time points are written as they are
+    ar << otf2::definition::clock_properties(otf2::chrono::ticks(1000000000),
+                                             otf2::chrono::ticks(0),
+                                             otf2::chrono::ticks(0));
+
+    std::vector<string> strings {
+        string(str_empty, ""),
+        string(str_machine, "machine"),
+        string(str_node, "node"),
+        string(str_posix_id, "POSIX"),
+        string(str_posix, "POSIX I/O"),
+        string(str_open, "open"),
+        string(str_close, "close"),
+        string(str_io, cfg.layered ? (cfg.read ? "MPI_File_read" : "MPI_File_write")
+                                   : cfg.async ? (cfg.read ? "aio_read" : "aio_write")
+                                               : (cfg.read ? "read" : "write")),
+        string(str_sync, sync_region_name(cfg.sync)),
+        string(str_world, "MPI_COMM_WORLD"),
+        string(str_shared_file, "/scratch/rabbitxx/shared.dat"),
+        string(str_wait, "aio_suspend"),
+        string(str_mpiio_id, "MPI-IO"),
+        string(str_mpiio, "MPI I/O"),
+        string(str_waitall, "MPI_Waitall"),
+        string(str_posix_io, cfg.read ? "pread" : "pwrite"),
+    };
+    for (std::uint64_t loc = 0; loc < cfg.num_locations; ++loc)
+    {
+        strings.emplace_back(str_first_dynamic + 3 * loc, "rank " + std::to_string(loc));
+        strings.emplace_back(str_first_dynamic + 3 * loc + 1,
+                             "/scratch/rabbitxx/file." + std::to_string(loc) + ".dat");
+        strings.emplace_back(str_first_dynamic + 3 * loc + 2, "fd " + std::to_string(loc));
+    }
+    const auto str_first_group = str_first_dynamic + 3 * cfg.num_locations;
+    for (std::uint64_t group = 0; group < cfg.groups; ++group)
+    {
+        strings.emplace_back(str_first_group + group, "group " + std::to_string(group));
+    }
+    for (const auto& str : strings)
+    {
+        ar << str;
+    }
+
+    const otf2::definition::system_tree_node node(0, strings[str_machine], strings[str_node]);
+    ar << node;
+
+    const std::vector<otf2::definition::region> regions {
+        otf2::definition::region(reg_open, strings[str_open], strings[str_open], strings[str_empty],
+                                 otf2::definition::region::role_type::file_io_metadata,
+                                 otf2::definition::region::paradigm_type::io,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_close, strings[str_close], strings[str_close], strings[str_empty],
+                                 otf2::definition::region::role_type::file_io_metadata,
+                                 otf2::definition::region::paradigm_type::io,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_io, strings[str_io], strings[str_io], strings[str_empty],
+                                 otf2::definition::region::role_type::file_io,
+                                 otf2::definition::region::paradigm_type::io,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_sync, strings[str_sync], strings[str_sync], strings[str_empty],
+                                 cfg.sync == "p2p" || cfg.sync == "ip2p"
+                                     ? otf2::definition::region::role_type::point2point
+                                     : otf2::definition::region::role_type::barrier,
+                                 otf2::definition::region::paradigm_type::mpi,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_wait, strings[str_wait], strings[str_wait], strings[str_empty],
+                                 otf2::definition::region::role_type::file_io,
+                                 otf2::definition::region::paradigm_type::io,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_waitall, strings[str_waitall], strings[str_waitall],
+                                 strings[str_empty],
+                                 otf2::definition::region::role_type::point2point,
+                                 otf2::definition::region::paradigm_type::mpi,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+        otf2::definition::region(reg_posix_io, strings[str_posix_io], strings[str_posix_io],
+                                 strings[str_empty],
+                                 otf2::definition::region::role_type::file_io,
+                                 otf2::definition::region::paradigm_type::io,
+                                 otf2::definition::region::flags_type::none,
+                                 strings[str_empty], 0, 0),
+    };
+    for (const auto& region : regions)
+    {
+        ar << region;
+    }
+
+    std::vector<otf2::definition::location> locations;
+    otf2::definition::comm_locations_group comm_locations(0, strings[str_world],
+            otf2::definition::comm_locations_group::paradigm_type::mpi,
+            otf2::definition::comm_locations_group::group_flag_type::none);
+    const auto num_events = events_per_location(cfg);
+    for (std::uint64_t loc = 0; loc < cfg.num_locations; ++loc)
+    {
+        const otf2::definition::location_group lg(loc, strings[str_first_dynamic + 3 * loc],
+                otf2::definition::location_group::location_group_type::process, node);
+        ar << lg;
+        locations.emplace_back(loc, strings[str_first_dynamic + 3 * loc], lg,
+                otf2::definition::location::location_type::cpu_thread, num_events);
+        ar << locations.back();
+        comm_locations.add_member(locations.back());
+    }
+    ar << comm_locations;
+
+    otf2::definition::comm_group world_group(1, strings[str_world], comm_locations,
+            otf2::definition::comm_group::paradigm_type::mpi,
+            otf2::definition::comm_group::group_flag_type::none);
+    for (std::uint64_t rank = 0; rank < cfg.num_locations; ++rank)
+    {
+        world_group.add_member(rank);
+    }
+    ar << world_group;
+    const otf2::definition::comm world(0, strings[str_world], world_group);
+    ar << world;
+
+    // sub-communicators of the handles, only defined if the world is split
+    std::vector<otf2::definition::comm> group_comms;
+    for (std::uint64_t group = 0; cfg.groups > 1 && group < cfg.groups; ++group)
+    {
+        otf2::definition::comm_group comm_group(2 + group, strings[str_first_group + group],
+                comm_locations, otf2::definition::comm_group::paradigm_type::mpi,
+                otf2::definition::comm_group::group_flag_type::none);
+        for (auto rank = group; rank < cfg.num_locations; rank += cfg.groups)
+        {
+            comm_group.add_member(rank);
+        }
+        ar << comm_group;
+        group_comms.emplace_back(1 + group, strings[str_first_group + group], comm_group);
+        ar << group_comms.back();
+    }
+
+    const otf2::definition::io_paradigm posix(0, strings[str_posix_id], strings[str_posix],
+            otf2::common::io_paradigm_class_type::serial,
+            otf2::common::io_paradigm_flag_type::os, {}, {}, {});
+    ar << posix;
+    const otf2::definition::io_paradigm mpiio(1, strings[str_mpiio_id], strings[str_mpiio],
+            otf2::common::io_paradigm_class_type::parallel,
+            otf2::common::io_paradigm_flag_type::none, {}, {}, {});
+    if (cfg.layered)
+    {
+        ar << mpiio;
+    }
+
+    std::vector<otf2::definition::io_regular_file> files;
+    if (cfg.shared_file)
+    {
+        files.emplace_back(0, strings[str_shared_file], node);
+    }
+    else
+    {
+        for (std::uint64_t loc = 0; loc < cfg.num_locations; ++loc)
+        {
+            files.emplace_back(loc, strings[str_first_dynamic + 3 * loc + 1], node);
+        }
+    }
+    for (const auto& file : files)
+    {
+        ar << file;
+    }
+
+    // every location opens its own handle, a layered one an MPI-IO handle
+    // as parent of its POSIX handle
+    std::vector<otf2::definition::io_handle> handles;
+    std::vector<otf2::definition::io_handle> mpiio_handles;
+    std::vector<otf2::definition::io_handle> dup_handles;
+    std::vector<otf2::definition::io_handle> second_handles;
+    for (std::uint64_t loc = 0; loc < cfg.num_locations; ++loc)
+    {
+        const auto& file = cfg.shared_file ? files.front() : files[loc];
+        const auto& comm = group_comms.empty() ? world : group_comms[loc % cfg.groups];
+        if (cfg.layered)
+        {
+            mpiio_handles.emplace_back(cfg.num_locations + loc, file.name(), file, mpiio,
+                    otf2::common::io_handle_flag_type::none, comm);
+            ar << mpiio_handles.back();
+            handles.emplace_back(loc, strings[str_first_dynamic + 3 * loc + 2], file, posix,
+                    otf2::common::io_handle_flag_type::none, comm, mpiio_handles.back());
+        }
+        else
+        {
+            handles.emplace_back(loc, strings[str_first_dynamic + 3 * loc + 2], file, posix,
+                    otf2::common::io_handle_flag_type::none, comm);
+        }
+        ar << handles.back();
+        if (cfg.dup)
+        {
+            dup_handles.emplace_back(2 * cfg.num_locations + loc, strings[str_first_dynamic + 3 * loc + 2],
+                    file, posix, otf2::common::io_handle_flag_type::none, comm);
+            ar << dup_handles.back();
+            second_handles.emplace_back(3 * cfg.num_locations + loc, strings[str_first_dynamic + 3 * loc + 2],
+                    file, posix, otf2::common::io_handle_flag_type::none, comm);
+            ar << second_handles.back();
+        }
+    }
+
+    const auto mode = cfg.read ? otf2::common::io_operation_mode_type::read
+                               : otf2::common::io_operation_mode_type::write;
+    const auto collective_kind = cfg.sync == "allreduce" ? otf2::common::collective_type::all_reduce
+                                                         : otf2::common::collective_type::barrier;
+    // the phases begin after the handles are opened
+    const std::uint64_t first_phase = cfg.dup ? 6 : 4;
+    const std::uint64_t ticks_per_phase = (cfg.async ? cfg.io_per_phase * 5 + 3
+                                           : cfg.io_per_phase * (cfg.layered ? 12 : 4))
+                                          + (cfg.sync == "ip2p" ? 12 : 4);
+    using flag_t = std::underlying_type<otf2::common::io_operation_flag_type>::type;
+    const auto io_flag = static_cast<otf2::common::io_operation_flag_type>(
+            (cfg.async ? static_cast<flag_t>(otf2::common::io_operation_flag_type::non_blocking) : 0)
+            | (cfg.collective ? static_cast<flag_t>(otf2::common::io_operation_flag_type::collective) : 0));
+
+    for (std::uint64_t loc = 0; loc < cfg.num_locations; ++loc)
+    {
+        auto& writer = ar(locations[loc]);
+        const auto& handle = handles[loc];
+        tick_clock now;
+        std::uint64_t matching_id = 0;
+
+        writer << otf2::event::enter(now(), regions[reg_open]);
+        if (cfg.layered)
+        {
+            writer << otf2::event::io_create_handle(now(), mpiio_handles[loc],
+                    cfg.read ? otf2::common::io_access_mode_type::read_only
+                             : otf2::common::io_access_mode_type::write_only,
+                    cfg.read ? otf2::common::io_creation_flag_type::none
+                             : otf2::common::io_creation_flag_type::create,
+                    otf2::common::io_status_flag_type::none);
+        }
+        writer << otf2::event::io_create_handle(now(), handle,
+                cfg.read ? otf2::common::io_access_mode_type::read_only
+                         : otf2::common::io_access_mode_type::write_only,
+                cfg.read ? otf2::common::io_creation_flag_type::none
+                         : otf2::common::io_creation_flag_type::create,
+                otf2::common::io_status_flag_type::none);
+        if (cfg.dup)
+        {
+            writer << otf2::event::io_duplicate_handle(now(), handle, dup_handles[loc],
+                    otf2::common::io_status_flag_type::none);
+            writer << otf2::event::io_create_handle(now(), second_handles[loc],
+                    cfg.read ? otf2::common::io_access_mode_type::read_only
+                             : otf2::common::io_access_mode_type::write_only,
+                    otf2::common::io_creation_flag_type::none,
+                    otf2::common::io_status_flag_type::none);
+        }
+        writer << otf2::event::leave(now(), regions[reg_open]);
+
+        for (std::uint64_t phase = 0; phase < cfg.num_phases; ++phase)
+        {
+            // all locations start a phase at the same time
+            now.advance_to(first_phase + phase * ticks_per_phase);
+            const auto first_id = matching_id;
+            for (std::uint64_t i = 0; i < cfg.io_per_phase; ++i)
+            {
+                writer << otf2::event::enter(now(), regions[reg_io]);
+                if (cfg.layered)
+                {
+                    const auto& parent = mpiio_handles[loc];
+                    writer << otf2::event::io_operation_begin(now(), parent, mode,
+                            io_flag, cfg.bytes_per_io, matching_id);
+                    // the POSIX operations carrying out the MPI-IO operation
+                    const auto half = cfg.bytes_per_io / 2;
+                    for (const auto bytes : { half, cfg.bytes_per_io - half })
+                    {
+                        writer << otf2::event::enter(now(), regions[reg_posix_io]);
+                        writer << otf2::event::io_operation_begin(now(), handle, mode,
+                                otf2::common::io_operation_flag_type::none, bytes, 0);
+                        writer << otf2::event::io_operation_complete(now(), handle, bytes, 0);
+                        writer << otf2::event::leave(now(), regions[reg_posix_io]);
+                    }
+                    writer << otf2::event::io_operation_complete(now(), parent, cfg.bytes_per_io,
+                            matching_id);
+                }
+                else if (cfg.async)
+                {
+                    writer << otf2::event::io_operation_begin(now(), handle, mode,
+                            io_flag, cfg.bytes_per_io, matching_id);
+                    writer << otf2::event::io_operation_issued(now(), handle, matching_id);
+                }
+                else
+                {
+                    // cycle through the handle, its duplicate and the second handle
+                    const auto& io_handle = !cfg.dup || matching_id % 3 == 0 ? handle
+                                            : matching_id % 3 == 1 ? dup_handles[loc]
+                                                                   : second_handles[loc];
+                    writer << otf2::event::io_operation_begin(now(), io_handle, mode,
+                            io_flag, cfg.bytes_per_io, matching_id);
+                    writer << otf2::event::io_operation_complete(now(), io_handle, cfg.bytes_per_io,
+                            matching_id);
+                }
+                writer << otf2::event::leave(now(), regions[reg_io]);
+                ++matching_id;
+            }
+            if (cfg.async && cfg.io_per_phase > 0)
+            {
+                // wait for all operations, they complete in reverse order
+                writer << otf2::event::enter(now(), regions[reg_wait]);
+                writer << otf2::event::io_operation_test(now(), handle, first_id);
+                for (auto id = matching_id; id > first_id; --id)
+                {
+                    writer << otf2::event::io_operation_complete(now(), handle, cfg.bytes_per_io,
+                            id - 1);
+                }
+                writer << otf2::event::leave(now(), regions[reg_wait]);
+            }
+
+            if (cfg.sync == "barrier" || cfg.sync == "allreduce")
+            {
+                writer << otf2::event::enter(now(), regions[reg_sync]);
+                writer << otf2::event::mpi_collective_begin(now());
+                writer << otf2::event::mpi_collective_end(now(), collective_kind, world,
+                        std::numeric_limits<std::uint32_t>::max(), 0, 0);
+                writer << otf2::event::leave(now(), regions[reg_sync]);
+            }
+            else if (cfg.sync == "p2p")
+            {
+                const auto right = (loc + 1) % cfg.num_locations;
+                const auto left = (loc + cfg.num_locations - 1) % cfg.num_locations;
+                writer << otf2::event::enter(now(), regions[reg_sync]);
+                writer << otf2::event::mpi_send(now(), right, world, phase, cfg.bytes_per_io);
+                writer << otf2::event::mpi_receive(now(), left, world, phase, cfg.bytes_per_io);
+                writer << otf2::event::leave(now(), regions[reg_sync]);
+            }
+            else if (cfg.sync == "ip2p")
+            {
+                const auto right = (loc + 1) % cfg.num_locations;
+                const auto left = (loc + cfg.num_locations - 1) % cfg.num_locations;
+                // tags 2 * phase and 2 * phase + 1, requests 4 * phase + 0..1 for
+                // the sends and 4 * phase + 2..3 for the receives
+                writer << otf2::event::enter(now(), regions[reg_sync]);
+                for (std::uint64_t msg = 0; msg < 2; ++msg)
+                {
+                    writer << otf2::event::mpi_isend(now(), right, world, 2 * phase + msg,
+                            cfg.bytes_per_io, 4 * phase + msg);
+                    writer << otf2::event::mpi_ireceive_request(now(), 4 * phase + 2 + msg);
+                }
+                writer << otf2::event::leave(now(), regions[reg_sync]);
+                // the receives complete in reverse order, the sends in order
+                writer << otf2::event::enter(now(), regions[reg_waitall]);
+                for (std::uint64_t msg = 2; msg > 0; --msg)
+                {
+                    writer << otf2::event::mpi_ireceive(now(), left, world, 2 * phase + msg - 1,
+                            cfg.bytes_per_io, 4 * phase + 2 + msg - 1);
+                }
+                for (std::uint64_t msg = 0; msg < 2; ++msg)
+                {
+                    writer << otf2::event::mpi_isend_complete(now(), 4 * phase + msg);
+                }
+                writer << otf2::event::leave(now(), regions[reg_waitall]);
+            }
+        }
+
+        now.advance_to(first_phase + cfg.num_phases * ticks_per_phase);
+        writer << otf2::event::enter(now(), regions[reg_close]);
+        writer << otf2::event::io_destroy_handle(now(), handle);
+        if (cfg.layered)
+        {
+            writer << otf2::event::io_destroy_handle(now(), mpiio_handles[loc]);
+        }
+        if (cfg.dup)
+        {
+            writer << otf2::event::io_destroy_handle(now(), dup_handles[loc]);
+            writer << otf2::event::io_destroy_handle(now(), second_handles[loc]);
+        }
+        writer << otf2::event::leave(now(), regions[reg_close]);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    generator_config cfg;
+    std::string path;
+    std::string name;
+    std::string layout;
+
+    po::options_description description("trace_generator - Write synthetic OTF2 traces");
+
+    // clang-format off
+    description.add_options()
+        ("help,h", "Display help message")
+        ("out-dir,o",
+            po::value<std::string>(&path)->default_value("synthetic_trace"),
+            "Output directory of the archive")
+        ("name,n",
+            po::value<std::string>(&name)->default_value("traces"),
+            "Archive name")
+        ("locations,l",
+            po::value<std::uint64_t>(&cfg.num_locations)->default_value(4),
+            "Number of locations")
+        ("phases,p",
+            po::value<std::uint64_t>(&cfg.num_phases)->default_value(2),
+            "Number of I/O phases, separated by a synchronization")
+        ("io-per-phase,i",
+            po::value<std::uint64_t>(&cfg.io_per_phase)->default_value(4),
+            "Number of I/O operations per location and phase")
+        ("bytes,b",
+            po::value<std::uint64_t>(&cfg.bytes_per_io)->default_value(4096),
+            "Bytes per I/O operation")
+        ("sync,s",
+            po::value<std::string>(&cfg.sync)->default_value("barrier"),
+            "Synchronization between phases: barrier, allreduce, p2p, ip2p or none")
+        ("layout",
+            po::value<std::string>(&layout)->default_value("shared"),
+            "File layout: shared or fpp (file per process)")
+        ("read,r",
+            po::bool_switch(&cfg.read)->default_value(false),
+            "Read instead of write")
+        ("async,a",
+            po::bool_switch(&cfg.async)->default_value(false),
+            "Non-blocking I/O, completed in reverse order at the end of each phase")
+        ("collective,c",
+            po::bool_switch(&cfg.collective)->default_value(false),
+            "Collective I/O over the communicator of the handles")
+        ("groups,g",
+            po::value<std::uint64_t>(&cfg.groups)->default_value(1),
+            "Scope the handles to this many sub-communicators, location i belongs to group i % groups")
+        ("layered",
+            po::bool_switch(&cfg.layered)->default_value(false),
+            "MPI-IO operations, each carried out by two nested POSIX operations")
+        ("dup",
+            po::bool_switch(&cfg.dup)->default_value(false),
+            "Cycle the operations through the handle, a duplicate and a second handle of the file")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+        std::cerr << description;
+        return EXIT_SUCCESS;
+    }
+
+    if (cfg.num_locations == 0)
+    {
+        std::cerr << "need at least one location\n";
+        return EXIT_FAILURE;
+    }
+    if (cfg.groups == 0 || cfg.groups > cfg.num_locations)
+    {
+        std::cerr << "need between one and " << cfg.num_locations << " groups\n";
+        return EXIT_FAILURE;
+    }
+    if (cfg.layered && cfg.async)
+    {
+        std::cerr << "layered I/O is blocking\n";
+        return EXIT_FAILURE;
+    }
+    if (cfg.dup && (cfg.layered || cfg.async))
+    {
+        std::cerr << "duplicated handles are written with blocking POSIX I/O only\n";
+        return EXIT_FAILURE;
+    }
+    if (cfg.sync != "barrier" && cfg.sync != "allreduce" && cfg.sync != "p2p" && cfg.sync != "ip2p"
+            && cfg.sync != "none")
+    {
+        std::cerr << "unknown synchronization: " << cfg.sync << "\n";
+        return EXIT_FAILURE;
+    }
+    if (layout != "shared" && layout != "fpp")
+    {
+        std::cerr << "unknown file layout: " << layout << "\n";
+        return EXIT_FAILURE;
+    }
+    cfg.shared_file = layout == "shared";
+
+    write_trace(cfg, path, name);
+    return EXIT_SUCCESS;
+}